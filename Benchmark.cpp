@@ -0,0 +1,221 @@
+#include "Benchmark.h"
+#include "Screen.h"
+#include "Game.h"
+#include "GridSink.h"
+#include "NullSink.h"
+#include "Renderer.h"
+#include "Player.h"
+#include "GameContext.h"
+#include "TimerWheel.h"
+#include "Constants.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GameConstants;
+
+namespace {
+    // Builds map text with 'count' entities (keys, obstacles, torches, springs, switches) on random cells
+    std::vector<std::string> makeEntityMap(int count, std::mt19937& rng) {
+        const char kinds[] = { KEY, OBSTACLE, TORCH, SPRING, SWITCH_OFF };
+        std::vector<std::string> lines(Screen::MAX_Y, std::string(Screen::MAX_X, EMPTY));
+
+        std::vector<int> cells(Screen::MAX_X * Screen::MAX_Y);
+        for (int i = 0; i < (int)cells.size(); ++i) cells[i] = i;
+        std::shuffle(cells.begin(), cells.end(), rng);
+
+        for (int i = 0; i < count && i < (int)cells.size(); ++i) {
+            lines[cells[i] / Screen::MAX_X][cells[i] % Screen::MAX_X] = kinds[i % 5];
+        }
+        return lines;
+    }
+
+    int benchEntityLookup() {
+        constexpr int PROBES = 4096;
+        constexpr int ROUNDS = 2000;
+        const int maxEntities = Screen::MAX_X * Screen::MAX_Y;
+        const int counts[] = { 10, 100, 1000, 10000 };
+
+        std::mt19937 rng(12345);
+        std::vector<Point> probes;
+        for (int i = 0; i < PROBES; ++i) {
+            probes.emplace_back((int)(rng() % Screen::MAX_X), (int)(rng() % Screen::MAX_Y));
+        }
+
+        std::printf("Screen::hasEntityAt() lookup cost\n");
+        std::printf("%10s %10s %12s\n", "requested", "entities", "ns/lookup");
+        for (int requested : counts) {
+            int count = requested < maxEntities ? requested : maxEntities; // the board holds at most MAX_X*MAX_Y
+            Screen screen;
+            screen.parseMap(makeEntityMap(count, rng));
+
+            size_t hits = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (int r = 0; r < ROUNDS; ++r) {
+                for (const Point& p : probes) {
+                    if (screen.hasEntityAt(p)) ++hits;
+                }
+            }
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            double ns = std::chrono::duration<double, std::nano>(elapsed).count() / ((double)ROUNDS * PROBES);
+            std::printf("%10d %10d %12.2f   (hits %zu)\n", requested, count, ns, hits);
+        }
+        return 0;
+    }
+}
+
+namespace {
+    // One player wandering through maps packed with entities: every step collides with
+    // something (push, pick up, toggle, compress), so this times entity dispatch in Player::move
+    int benchPlayerMove() {
+        constexpr int STEPS = 20000;
+        constexpr int ROUNDS = 50;
+        const int cells = Screen::MAX_X * Screen::MAX_Y;
+        const int percents[] = { 10, 30, 60 };
+        const char moveKeys[] = "wdxa";
+
+        NullSink sink;
+        Renderer renderer(sink);
+        Renderer::Scope scope(renderer);
+
+        std::printf("Player::move() through dense entity maps (best of %d rounds)\n", ROUNDS);
+        std::printf("%10s %10s %12s\n", "density", "entities", "ns/move");
+        for (int percent : percents) {
+            std::mt19937 rng(777);
+            std::vector<std::string> lines = makeEntityMap(cells * percent / 100, rng);
+
+            auto screen = std::make_unique<Screen>();
+            TimerWheel timers;
+            std::vector<Player> players;
+            players.reserve(1);
+            GameContext context(*screen, timers, players);
+
+            double bestNs = 0;
+            for (int r = 0; r < ROUNDS; ++r) {
+                screen->parseMap(lines);
+                players.clear();
+                players.emplace_back(Point(Screen::MAX_X / 2, Screen::MAX_Y / 2), "wdxas", &context, 0);
+                screen->setCharAt(players[0].getPosition(), EMPTY);
+                Player& player = players[0];
+
+                std::mt19937 walk(r + 1);
+                auto start = std::chrono::steady_clock::now();
+                for (int s = 0; s < STEPS; ++s) {
+                    if (s % 4 == 0) player.handleKeyPressed(moveKeys[walk() % 4]);
+                    player.move();
+                    timers.advance();
+                }
+                double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / STEPS;
+                if (r == 0 || ns < bestNs) bestNs = ns;
+            }
+            std::printf("%9d%% %10d %12.2f\n", percent, cells * percent / 100, bestNs);
+        }
+        return 0;
+    }
+}
+
+namespace {
+    // Bytes held by the entity table: a full board as parsed, and a 10,000-row table
+    // (more entities than one 80x22 board has cells, as a stand-in for a large map)
+    int benchEntityMemory() {
+        constexpr int STRESS_ROWS = 10000;
+        const int cells = Screen::MAX_X * Screen::MAX_Y;
+        const size_t rowBytes = sizeof(std::uint16_t) + sizeof(EntityKind) + sizeof(std::uint8_t);
+
+        std::mt19937 rng(12345);
+        auto screen = std::make_unique<Screen>();
+        screen->parseMap(makeEntityMap(cells, rng));
+        const EntityTable& parsed = screen->getEntities();
+
+        EntityTable stress;
+        for (int i = 0; i < STRESS_ROWS; ++i) {
+            stress.add((std::uint16_t)(i % cells), (EntityKind)(i % 5));
+        }
+
+        std::printf("Entity table memory (%zu bytes per row)\n", rowBytes);
+        std::printf("%10s %12s %12s\n", "entities", "used bytes", "capacity");
+        std::printf("%10zu %12zu %12zu\n", parsed.size(), parsed.size() * rowBytes, parsed.capacityBytes());
+        std::printf("%10zu %12zu %12zu\n", stress.size(), stress.size() * rowBytes, stress.capacityBytes());
+        return 0;
+    }
+}
+
+namespace {
+    // One headless session driven by seeded random keys; returns a hash of every frame
+    unsigned long long runSeededSession(unsigned seed, int ticks) {
+        const char keys[] = "wdxaseilmjkoeRr";
+        std::mt19937 rng(seed);
+
+        GridSink sink;
+        Game game(&sink);
+        if (!game.begin()) return 0;
+
+        unsigned long long hash = 14695981039346656037ull;
+        for (int t = 0; t < ticks && game.isRunning(); ++t) {
+            if (rng() % 3 == 0) game.handleInput(keys[rng() % (sizeof(keys) - 1)]);
+            game.tick();
+
+            for (int y = 0; y < RenderSink::HEIGHT; ++y) {
+                std::string row = sink.getRow(y);
+                size_t time = row.find("Time: "); // wall-clock seconds differ between runs
+                if (time != std::string::npos) row.replace(time + 6, 3, "***");
+                for (char c : row) hash = (hash ^ (unsigned char)c) * 1099511628211ull;
+            }
+        }
+        return hash;
+    }
+
+    // Games share no mutable state: sessions run concurrently must match the same sessions run one by one
+    int benchParallelSessions() {
+        constexpr int SESSIONS = 64;
+        constexpr int TICKS = 2000;
+
+        std::vector<unsigned long long> serial(SESSIONS), parallel(SESSIONS);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < SESSIONS; ++i) {
+            serial[i] = runSeededSession((unsigned)i + 1, TICKS);
+        }
+        double serialMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int i = 0; i < SESSIONS; ++i) {
+            threads.emplace_back([i, &parallel] { parallel[i] = runSeededSession((unsigned)i + 1, TICKS); });
+        }
+        for (auto& thread : threads) thread.join();
+        double parallelMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        int mismatches = 0;
+        for (int i = 0; i < SESSIONS; ++i) {
+            if (serial[i] == 0) {
+                std::fprintf(stderr, "session %d could not start (is Data/ present?)\n", i);
+                return 1;
+            }
+            if (serial[i] != parallel[i]) {
+                std::printf("session %2d differs: serial %016llx, threaded %016llx\n", i, serial[i], parallel[i]);
+                ++mismatches;
+            }
+        }
+
+        std::printf("%d sessions x %d ticks: serial %.1f ms, %d threads %.1f ms\n",
+            SESSIONS, TICKS, serialMs, SESSIONS, parallelMs);
+        std::printf("%s\n", mismatches ? "MISMATCH" : "all sessions match");
+        return mismatches ? 1 : 0;
+    }
+}
+
+int runBenchmark(const std::string& name) {
+    if (name == "lookup") return benchEntityLookup();
+    if (name == "sessions") return benchParallelSessions();
+    if (name == "move") return benchPlayerMove();
+    if (name == "memory") return benchEntityMemory();
+
+    std::fprintf(stderr, "Unknown benchmark '%s'. Available: lookup, sessions, move, memory\n", name.c_str());
+    return 1;
+}
@@ -0,0 +1,6 @@
+#pragma once
+#include <string>
+
+// Command-line micro benchmarks (run with: game --bench <name>)
+// Returns the process exit code.
+int runBenchmark(const std::string& name);
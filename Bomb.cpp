@@ -1,17 +1,8 @@
 ﻿#include "Bomb.h"
 
-Bomb::Bomb(int x, int y)
+Bomb::Bomb(int x, int y, long long plantedTick, int tickRate)
     : position(x, y),
-    timer(EXPLODE_TICKS),
-    bombed(false)
+    ticksPerSecond(tickRate < 1 ? 1 : tickRate),
+    explodeTick(plantedTick + FUSE_SECONDS * ticksPerSecond)
 {
 }
-
-void Bomb::update() {
-    if (timer > 0) {
-        --timer;
-        if (timer == 0) {
-            bombed = true;
-        }
-    }
-}
\ No newline at end of file
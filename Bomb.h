@@ -4,40 +4,40 @@
 class Player;
 class Screen;
 
+// A planted bomb. Its countdown and detonation run as TimerWheel events owned by Game.
 class Bomb {
     Point position;
-    int timer;
-    bool bombed = false;
+    int ticksPerSecond;    // game cycles per second the fuse was lit at
+    long long explodeTick; // wheel tick on which the bomb detonates
 
-	static constexpr int EXPLODE_TICKS = 40; // 4 seconds if update() is called
+	static constexpr int FUSE_SECONDS = 4;
     static constexpr int BLAST_RADIUS = 3; 
 
 public:
-    Bomb(int x, int y);
+    Bomb(int x, int y, long long plantedTick, int tickRate);
 
-	void update(); // updates the timer and explosion status
-
-	int getTimer() const  // returns time in seconds
+	int getTimer(long long tick) const  // returns time left at the given tick in seconds
     {
-        return (timer / 10);
+        return (int)((explodeTick - tick) / ticksPerSecond);
     }
 
-	bool hasExploded() const // returns true if bomb has exploded
-    { 
-        return bombed;
-    }
-  
 	Point getPosition() const // returns position of the bomb
      { 
         return position; 
      }
 
-	static constexpr int getBlastRadius() // returns blast radius in number of cells
+	int getFuseTicks() const // ticks from planting to detonation
     {
-       return BLAST_RADIUS; 
+        return FUSE_SECONDS * ticksPerSecond;
     }
 
+	int getTicksPerSecond() const // ticks per countdown digit
+    {
+        return ticksPerSecond;
+    }
 
-
-
+	static constexpr int getBlastRadius() // returns blast radius in number of cells
+    {
+       return BLAST_RADIUS; 
+    }
 };
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+#include "TileTable.h"
+
+// What one step needs to know about a cell, read in one go by Screen::probe():
+// the glyph, its tile class, the entity on it and which players stand on it.
+struct CellProbe {
+    // The glyph's Tiles flags, plus what only the position can tell
+    enum Tile : std::uint16_t {
+        SOLID = Tiles::SOLID,
+        PUSHABLE = Tiles::PUSHABLE,
+        DOOR = Tiles::DOOR,
+        LEGEND = 0x100    // on the legend row
+    };
+
+    char glyph = 0;
+    std::uint16_t tile = 0;   // Tile flags
+    std::uint8_t players = 0; // Screen::occupantBit of every active player standing here
+    std::uint16_t entity = 0; // entity handle for Screen::collide, 0 = none
+
+    bool is(Tile flag) const { return (tile & flag) != 0; }
+};
@@ -6,8 +6,6 @@
 
 using namespace GameConstants; // using namespace to avoid prefixing constants
 
-bool Door::openDoors[MAX_DOORS] = { false };// static array to track open state of doors
-
 Door::Door(int number, const Point& pos, int switchGroup, bool needsKey)// constructor
     : doorNumber(number), position(pos), switchGroupId(switchGroup), requiresKey(needsKey)
 {
@@ -21,20 +19,20 @@ void Door::draw() const
     position.draw(c);
 }
 
-void Door::resetAllDoors()
+void DoorState::resetAll()
 {// reset all doors to closed state
     for (int i = 0; i < MAX_DOORS; ++i)
         openDoors[i] = false;
 }
 
-bool Door::isOpen(char doorChar) // check if a door is open
+bool DoorState::isOpen(char doorChar) const // check if a door is open
 {
     if (doorChar < DOOR_START || doorChar > DOOR_END) return false;
     int index = doorChar - DOOR_START;
     return openDoors[index];
 }
 
-void Door::setOpen(char doorChar, bool open) // set the open state of a door
+void DoorState::setOpen(char doorChar, bool open) // set the open state of a door
 {
     if (doorChar < DOOR_START || doorChar > DOOR_END) return;
     int index = doorChar - DOOR_START;
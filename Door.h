@@ -6,8 +6,17 @@
 class Player;// forward declaration
 class Screen;
 
+// Open/closed state of the doors of one game session (kept in GameContext)
+class DoorState {
+    bool openDoors[GameConstants::MAX_DOORS] = { false };
+
+public:
+    void resetAll();
+    bool isOpen(char doorChar) const;
+    void setOpen(char doorChar, bool open);
+};
+
 class Door : public GameObject {
-    static bool openDoors[GameConstants::MAX_DOORS];
     int doorNumber;
     Point position;
     int switchGroupId = GameConstants::NO_SWITCH_GROUP; // associated switch group
@@ -23,10 +32,4 @@ public:
 
     // Door specific methods
     char getChar() const { return (char)((GameConstants::DOOR_START - 1) + doorNumber); }
-
-    // Static door state management
-    static void resetAllDoors();
-    static bool isOpen(char doorChar);
-    static void setOpen(char doorChar, bool open);
-
 };
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include <variant>
+#include <vector>
+#include "Key.h"
+#include "Obstacle.h"
+#include "Torch.h"
+#include "Switch.h"
+#include "Spring.h"
+
+enum class EntityKind : std::uint8_t { KEY, OBSTACLE, TORCH, SWITCH, SPRING };
+
+// One entity as its class, built from a table row while it handles a collision.
+// std::visit picks the alternative through a jump table, and since the classes are
+// final the call it makes is a direct one instead of a virtual call through GameObject.
+// The alternatives are in EntityKind order, so a row's kind is its variant index.
+using Entity = std::variant<Key, Obstacle, Torch, Switch, Spring>;
+
+static_assert(std::is_same_v<std::variant_alternative_t<static_cast<size_t>(EntityKind::SWITCH), Entity>, Switch> &&
+              std::is_same_v<std::variant_alternative_t<static_cast<size_t>(EntityKind::SPRING), Entity>, Spring>,
+              "Entity alternatives must follow EntityKind");
+
+// The entities of a map as parallel arrays, one row per entity: its cell (packed
+// y * width + x), its kind and the state byte some kinds need. Scans over cells or
+// kinds touch a few bytes per entity; an Entity is only built from a row while it
+// handles a collision.
+struct EntityTable {
+    // state of a SWITCH row, same layout as the level pack's switch flags
+    static constexpr std::uint8_t SWITCH_ON = 0x80;
+    static constexpr std::uint8_t SWITCH_GROUP = 0x7f;
+
+    std::vector<std::uint16_t> cell;
+    std::vector<EntityKind> kind;
+    std::vector<std::uint8_t> state;
+
+    size_t size() const { return cell.size(); }
+
+    void add(std::uint16_t at, EntityKind what, std::uint8_t bits = 0) {
+        cell.push_back(at);
+        kind.push_back(what);
+        state.push_back(bits);
+    }
+
+    // O(1) removal: the last row takes the place of row i
+    void removeSwap(size_t i) {
+        cell[i] = cell.back();
+        kind[i] = kind.back();
+        state[i] = state.back();
+        cell.pop_back();
+        kind.pop_back();
+        state.pop_back();
+    }
+
+    void clear() {
+        cell.clear();
+        kind.clear();
+        state.clear();
+    }
+
+    size_t capacityBytes() const {
+        return cell.capacity() * sizeof(cell[0]) + kind.capacity() * sizeof(kind[0]) + state.capacity() * sizeof(state[0]);
+    }
+};
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// The cells a light at (centerX, centerY) reaches within radius: board indices
+// (y * width + x), each listed once, center first.
+struct LightField {
+    int centerX = 0;
+    int centerY = 0;
+    int radius = 0;
+    std::vector<std::uint16_t> cells;
+};
+
+namespace FieldOfView {
+    namespace detail {
+        // Octant transforms for recursive shadowcasting
+        constexpr int XX[8] = { 1, 0, 0, -1, -1, 0, 0, 1 };
+        constexpr int XY[8] = { 0, 1, -1, 0, 0, -1, 1, 0 };
+        constexpr int YX[8] = { 0, 1, 1, 0, 0, -1, -1, 0 };
+        constexpr int YY[8] = { 1, 0, 0, 1, -1, 0, 0, -1 };
+
+        template <typename IsOpaque, typename Light>
+        void castLight(int cx, int cy, int row, double start, double end, int radius, int octant,
+            int width, int height, const IsOpaque& isOpaque, const Light& light)
+        {
+            if (start < end) return;
+            double newStart = 0.0;
+            for (int j = row; j <= radius; ++j) {
+                bool blocked = false;
+                int dy = -j;
+                for (int dx = -j; dx <= 0; ++dx) {
+                    int x = cx + dx * XX[octant] + dy * XY[octant];
+                    int y = cy + dx * YX[octant] + dy * YY[octant];
+                    double leftSlope = (dx - 0.5) / (dy + 0.5);
+                    double rightSlope = (dx + 0.5) / (dy - 0.5);
+                    if (start < rightSlope) continue;
+                    if (end > leftSlope) break;
+
+                    bool inside = x >= 0 && x < width && y >= 0 && y < height;
+                    if (inside && dx * dx + dy * dy <= radius * radius) light(x, y);
+
+                    bool opaque = !inside || isOpaque(x, y);
+                    if (blocked) {
+                        if (opaque) {
+                            newStart = rightSlope;
+                            continue;
+                        }
+                        blocked = false;
+                        start = newStart;
+                    }
+                    else if (opaque && j < radius) {
+                        // a wall starts: scan the lit part beyond it, then continue after it
+                        blocked = true;
+                        castLight(cx, cy, j + 1, start, leftSlope, radius, octant, width, height, isOpaque, light);
+                        newStart = rightSlope;
+                    }
+                }
+                if (blocked) break;
+            }
+        }
+    }
+
+    // Recursive shadowcasting: opaque cells are lit themselves but hide what lies behind them
+    template <typename IsOpaque>
+    void compute(LightField& field, int width, int height, const IsOpaque& isOpaque) {
+        const int r = field.radius;
+        const int side = 2 * r + 1;
+        std::vector<bool> seen((size_t)side * side, false);
+        field.cells.clear();
+
+        auto light = [&](int x, int y) {
+            size_t local = (size_t)(y - field.centerY + r) * side + (size_t)(x - field.centerX + r);
+            if (seen[local]) return; // octant edges are visited twice
+            seen[local] = true;
+            field.cells.push_back((std::uint16_t)(y * width + x));
+        };
+
+        if (field.centerX < 0 || field.centerX >= width || field.centerY < 0 || field.centerY >= height) return;
+        light(field.centerX, field.centerY);
+        for (int octant = 0; octant < 8; ++octant) {
+            detail::castLight(field.centerX, field.centerY, 1, 1.0, 0.0, r, octant, width, height, isOpaque, light);
+        }
+    }
+}
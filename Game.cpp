@@ -1,20 +1,35 @@
 ﻿#include "Game.h"
 #include "Door.h"
 #include "Riddle.h"
+#include "InputLog.h"
+#include "GameAssets.h"
 #include "utils.h"
 #include "console.h"
 #include <iostream>
+#include <fstream>
 #include <cmath>
 
 // using namespace to avoid prefixing constants
 using namespace GameConstants;
 
 
-Game::Game()
-    : running(false), paused(false), lastLegendSeconds(-1){}
+Game::Game(RenderSink* sink, const GameOptions& gameOptions)
+    : options(gameOptions), scheduler(gameOptions.tickRate),
+    renderer(sink ? *sink : terminalSink), running(false), paused(false), lastLegendSeconds(-1),
+    context(screen, timers, players)
+{
+    profiler.setEnabled(options.profile);
+    terminalSink.setColors(options.colors);
+    context.soundEnabled = options.sound;
+    screen.setKeepRevealed(options.keepRevealed);
+    // doors read the group state on contact; just give feedback when a group completes
+    screen.setSwitchGroupListener([this](int) { context.playSound("switches_on"); });
+}
+
 bool Game::init()
 {
     // Delegate discovery to Screen and then copy results into Game
+    screen.useAssets(options.assets);
     if (!screen.loadScreenFiles()) {
         initError = "No screen files found (adv-world*.screen)";
         return false;
@@ -23,7 +38,10 @@ bool Game::init()
 
     // Load and validate riddles game must not start without them
     std::string riddleError;
-    if (!initRiddles(riddleError)) {
+    if (options.assets) {
+        context.riddles.assign(options.assets->getRiddles());
+    }
+    else if (!context.riddles.load(riddleError)) {
         initError = riddleError;
         return false;
     }
@@ -84,11 +102,42 @@ void Game::placeLegend()
 }
 
 void Game::spawnBombAt(int x, int y)
-{// spawn bomb at given coordinates
-    bombs.emplace_back(x, y);
-    int t = bombs.back().getTimer();
-    char c = (t > TIMER_MIN_DIGIT && t <= TIMER_MAX_DIGIT) ? char('0' + t) : 'o';
-    screen.setCharAt(x, y, c);
+{// spawn bomb at given coordinates and schedule its countdown
+    int id;
+    if (!freeBombIds.empty()) {
+        id = freeBombIds.back();
+        freeBombIds.pop_back();
+        bombs[id] = Bomb(x, y, timers.now(), scheduler.getTickRate());
+    }
+    else {
+        id = (int)bombs.size();
+        bombs.emplace_back(x, y, timers.now(), scheduler.getTickRate());
+    }
+
+    // the digit shown at the end of this cycle
+    drawBombTimer(id, timers.now() + 1);
+
+    // one event per digit change (ticks left 29, 19, 9 at 10 Hz), then the detonation
+    const int fuse = bombs[id].getFuseTicks();
+    const int perDigit = bombs[id].getTicksPerSecond();
+    for (int left = fuse - 1 - perDigit; left > 0; left -= perDigit) {
+        timers.schedule(fuse - left, [this, id] { drawBombTimer(id, timers.now()); });
+    }
+    timers.schedule(fuse, [this, id] { detonateBomb(id); });
+}
+
+void Game::drawBombTimer(int bombId, long long tick)
+{// show the seconds left on the bomb's cell
+    const Bomb& bomb = bombs[bombId];
+    int t = bomb.getTimer(tick);
+    char c = (t >= TIMER_MIN_DIGIT && t <= TIMER_MAX_DIGIT) ? char('0' + t) : 'o';
+    screen.setCharAt(bomb.getPosition().getX(), bomb.getPosition().getY(), c);
+}
+
+void Game::detonateBomb(int bombId)
+{
+    processExplosion(bombs[bombId].getPosition(), Bomb::getBlastRadius());
+    freeBombIds.push_back(bombId);
 }
 
 void Game::tryDropBomb(int playerIndex)
@@ -98,7 +147,7 @@ void Game::tryDropBomb(int playerIndex)
     if (p.disposeBomb()) {
         Point pos = p.getPosition();
         spawnBombAt(pos.getX(), pos.getY());
-        playSound("bomb_drop");
+        context.playSound("bomb_drop");
     }
     else {
         p.disposeElement();
@@ -107,21 +156,26 @@ void Game::tryDropBomb(int playerIndex)
 
 void Game::processExplosion(const Point& center, int radius)
 {// process bomb explosion effects
-    playSound("explosion");
-
-    // clearing of visuals
-    for (int dy = -radius; dy <= radius; ++dy) {
-        for (int dx = -radius; dx <= radius; ++dx) {
-            if (std::abs(dx) <= radius && std::abs(dy) <= radius) {
-                int tx = center.getX() + dx;
-                int ty = center.getY() + dy;
-
-                if (tx >= 0 && tx < Screen::MAX_X && ty >= 0 && ty < Screen::MAX_Y) {
-					if (screen.getCharAt(tx, ty) == KEY ||( screen.getCharAt(tx,ty)>= DOOR_START && screen.getCharAt(tx,ty)<=DOOR_END))
-                        continue;
-                    if(statusRow==ty)
-                        continue;
-                    screen.setCharAt(tx, ty, EMPTY);
+    context.playSound("explosion");
+
+    // clearing of visuals (redrawn together when the batch ends)
+    {
+        Screen::Batch batch(screen);
+        for (int dy = -radius; dy <= radius; ++dy) {
+            for (int dx = -radius; dx <= radius; ++dx) {
+                if (std::abs(dx) <= radius && std::abs(dy) <= radius) {
+                    int tx = center.getX() + dx;
+                    int ty = center.getY() + dy;
+
+                    if (tx >= 0 && tx < Screen::MAX_X && ty >= 0 && ty < Screen::MAX_Y) {
+                        const Tiles::Info& tile = Tiles::of(screen.charAtUnchecked(tx, ty)); // inside the map, checked above
+                        if (tile.has(Tiles::BLAST_PROOF))
+                            continue;
+                        if(statusRow==ty)
+                            continue;
+                        screen.destroyEntityAt(Point(tx, ty)); // its row and handle go with the glyph
+                        screen.setCharAt(tx, ty, EMPTY);
+                    }
                 }
             }
         }
@@ -129,7 +183,11 @@ void Game::processExplosion(const Point& center, int radius)
 
     //hit players
     for (size_t j = 0; j < players.size(); ++j) {
+        int livesBefore = players[j].getLives();
         players[j].applyExplosion(center, radius);
+        if (context.observer && players[j].getLives() < livesBefore) {
+            context.observer->onBombHit(screen.getCurrentMap(), (int)j);
+        }
     }
 }
 
@@ -167,29 +225,14 @@ void Game::tryRevivePlayer()
         deadPlayer->setInitPosition(revivedPos);
         deadPlayer->draw();
 
-        playSound("revive");
+        context.playSound("revive");
         legend.forceRefresh();
     }
 }
 
-void Game::updateBombs()
-{// update all bombs
-    for (size_t i = 0; i < bombs.size(); ) {
-        bombs[i].update();
-
-        if (bombs[i].hasExploded()) {
-            processExplosion(bombs[i].getPosition(), Bomb::getBlastRadius());
-            bombs.erase(bombs.begin() + i);
-        }
-        else {
-            Point bp = bombs[i].getPosition();
-            int t = bombs[i].getTimer();
-            if (t > TIMER_MIN_DIGIT && t <= TIMER_MAX_DIGIT) {
-                screen.setCharAt(bp.getX(), bp.getY(), char('0' + t));
-            }
-            ++i;
-        }
-    }
+void Game::updateTimers()
+{// only the events due this cycle are touched
+    timers.advance();
 }
 
 void Game::updatePlayers()
@@ -210,7 +253,7 @@ void Game::startLevel(int mapIndex)
     if (!screen.setMap(mapIndex)) {
         return;
     }
-    Door::resetAllDoors();
+    context.doors.resetAll();
 
     // Reset players
     for (auto& player : players) {
@@ -233,6 +276,9 @@ void Game::startLevel(int mapIndex)
     // Update and draw
     players[PLAYER1_INDEX].setInitPosition(nextSpawn1);
     players[PLAYER2_INDEX].setInitPosition(nextSpawn2);
+    for (auto& player : players) {
+        player.updateLight();
+    }
 
     screen.draw();
 
@@ -243,18 +289,23 @@ void Game::startLevel(int mapIndex)
         player.draw();
     }
     drawStatusLine();
+
+    if (context.observer) context.observer->onLevelStart(mapIndex, tickCount);
 }
 
 void Game::displayGameOverScreen() {
-    playSound("game_over");
+    context.playSound("game_over");
     int gameOverScreenIndex = screen.getNumScreens() - 1;
     if (screen.setMap(gameOverScreenIndex)) {
-        cls();
+        renderer.clear();
         screen.draw();
+        renderer.present();
+    }
+    if (renderer.isInteractive()) {
+        sleep_ms(GAME_OVER_DISPLAY_MS);
+        while (!check_kbhit()) { sleep_ms(50); }
+        get_single_char();
     }
-    sleep_ms(GAME_OVER_DISPLAY_MS);
-    while (!check_kbhit()) { sleep_ms(50); }
-    get_single_char();
     running = false;
 }
 
@@ -273,29 +324,19 @@ void Game::handleLevelTransition()
     }
 
     // Both players passed through a door - transition to next level
-    playSound("level_finish");
+    context.playSound("level_finish");
 
     int currentMap = screen.getCurrentMap();
-    int nextMap = 0;
     int doorUsed = players[PLAYER1_INDEX].getLastDoorPassed();
 
     if (doorUsed == -1) {
         doorUsed = players[PLAYER2_INDEX].getLastDoorPassed();
     }
 
-    // Generic door navigation:
-    // Door '1' (index 0): from lobby goes forward, from other maps goes back to lobby
-    // Door 'N' (index N-1, where N > 1) goes to map N
-    if (doorUsed == 0) {  // Door '1'
-        if (currentMap == 0) {
-            nextMap = 1;  // From lobby, go to first level
-        } else {
-            nextMap = 0;  // From any level, go back to lobby
-        }
-    }
-    else {
-        nextMap = doorUsed + 1;  // Door 'N' goes to map N
-    }
+    // Generic door navigation (the screen prefetches the same destinations)
+    int nextMap = Screen::doorDestination(currentMap, doorUsed);
+
+    if (context.observer) context.observer->onLevelComplete(currentMap, nextMap, tickCount);
 
     if (nextMap < (int)screenFiles.size()) {
         // Check if transitioning to the game over screen (last screen)
@@ -313,24 +354,26 @@ void Game::handleLevelTransition()
 
 void Game::handleInput(char key)
 {
+    Renderer::Scope bind(renderer);
+    if (isRecording()) {
+        inputLog.add(tickCount, InputLog::Kind::KEY, key);
+    }
+
     if (key == KEY_ESC)
     { 
         if (!paused)
         {
             paused = true;
-            pauseStartTime = std::chrono::steady_clock::now();
+            pauseStartTick = tickCount;
 
-            gotoxy(0, statusRow);
-            setTextColor(static_cast<int>(Color::Yellow));
-            std::cout << "          >>> PAUSED. Press ESC to Continue, H to return to Menu <<<                 ";
-            std::cout.flush();
-            setTextColor(static_cast<int>(Color::White));
+            renderer.putText(0, statusRow,
+                "          >>> PAUSED. Press ESC to Continue, H to return to Menu <<<                 ",
+                static_cast<int>(Color::Yellow));
         }
         else {
             paused = false;
             drawStatusLine();
-            auto now = std::chrono::steady_clock::now();
-            startTime += (now - pauseStartTime);
+            startTick += tickCount - pauseStartTick;
             legend.forceRefresh();
         }
     }
@@ -353,11 +396,15 @@ void Game::handleInput(char key)
         }
 
         else if (key == '1') {
-            setSoundEnabled(true);
+            context.soundEnabled = true;
             drawStatusLine();
         }
         else if (key == '0') {
-            setSoundEnabled(false);
+            context.soundEnabled = false;
+            drawStatusLine();
+        }
+        else if (key == PROFILER_KEY_LOWER || key == PROFILER_KEY_UPPER) {
+            profiler.toggle();
             drawStatusLine();
         }
         else {
@@ -370,29 +417,19 @@ void Game::handleInput(char key)
 
 void Game::drawLegend()
 {
-    int seconds; // Time calculation logic assisted by AI
-
-    if (paused) {
-        seconds = (int)std::chrono::duration_cast<std::chrono::seconds>(
-            pauseStartTime - startTime).count();
-    }
-    else {
-        auto now = std::chrono::steady_clock::now();
-        seconds = (int)std::chrono::duration_cast<std::chrono::seconds>(
-            now - startTime).count();
-    }
+    long long elapsed = (paused ? pauseStartTick : tickCount) - startTick;
+    int seconds = (int)(elapsed / scheduler.getTickRate());
 
     legend.drawLegend(players[PLAYER1_INDEX], players[PLAYER2_INDEX], seconds);
 
 }
 
 void Game::initializeGameSession() {
-    cls();
-    Door::resetAllDoors();
-    resetRiddlesIndex();
-    hideCursor();
+    renderer.clear();
+    context.doors.resetAll();
+    context.riddles.resetIndex();
 
-    if (!screen.setMap(STARTING_MAP_INDEX)) {
+    if (!screen.setMap(options.startMap)) {
         showErrorMessage(std::string("Failed to load map: ") + screen.getLastError());
         return;
     }
@@ -401,15 +438,19 @@ void Game::initializeGameSession() {
     Point spawn1 = findSafeSpawn(PLAYER1_SPAWN_X, PLAYER1_SPAWN_Y, MIN_SPAWN_SEARCH_RADIUS, 0, '$');
     Point spawn2 = findSafeSpawn(PLAYER2_SPAWN_X, PLAYER2_SPAWN_Y, 0, MIN_SPAWN_SEARCH_RADIUS, '&');
 
+    // pending events may refer to the previous players and bombs
+    timers.clear();
+    bombs.clear();
+    freeBombIds.clear();
+
     players.clear();
     players.reserve(2);
-    players.emplace_back(spawn1, "wdxas", &screen);
-    players.emplace_back(spawn2, "ilmjk", &screen);
-
-    Player::registerPlayers(players.data(), (int)players.size());
+    players.emplace_back(spawn1, "wdxas", &context, PLAYER1_INDEX);
+    players.emplace_back(spawn2, "ilmjk", &context, PLAYER2_INDEX);
 
     placeLegend();
-    startTime = std::chrono::steady_clock::now();
+    startTick = tickCount;
+    if (context.observer) context.observer->onLevelStart(options.startMap, tickCount);
 
     for (auto& player : players) {
         player.draw();
@@ -422,57 +463,183 @@ void Game::initializeGameSession() {
     paused = false;
 }
 void Game::drawStatusLine() {
-    gotoxy(0, statusRow);
-    setTextColor(static_cast<int>(Color::Cyan));
-    std::cout << "                  Press ESC for pause | Sound["
-        << (isSoundEnabled() ? "on" : "off") << "]                                     ";
-    std::cout.flush();
-    setTextColor(static_cast<int>(Color::White));
+    std::string line = "                  Press ESC for pause | Sound[";
+    line += context.soundEnabled ? "on" : "off";
+    line += "]";
+    if (profiler.isEnabled()) {
+        line += " | Profiler[on]";
+    }
+    line += "                                     ";
+    renderer.putText(0, statusRow, line, static_cast<int>(Color::Cyan));
 }
-void Game::run()
+bool Game::begin()
 {
+    Renderer::Scope bind(renderer);
     if (!init()) {
         std::cerr << "Game init failed: " << initError << std::endl;
-        return;
+        return false;
     }
     drawStatusLine();
+    if (isRecording()) {
+        startRecording();
+    }
     initializeGameSession();
+    return running;
+}
 
-    while (running) {
-        if (check_kbhit()) {
-            handleInput(get_single_char());
-        }
+void Game::startRecording()
+{
+    InputLog::Header header;
+    header.tickRate = options.tickRate;
+    header.startMap = options.startMap;
+    header.mapCount = getScreenCount();
+    header.sound = context.soundEnabled;
+    header.colors = options.colors;
+    header.keepRevealed = options.keepRevealed;
+    inputLog = InputLog();
+    inputLog.setHeader(header);
+
+    // riddle prompts read the keyboard themselves; log what they got
+    context.riddles.setAnswerSource([this] {
+        char answer = readRiddleAnswerFromKeyboard();
+        inputLog.add(tickCount, InputLog::Kind::RIDDLE_ANSWER, answer);
+        return answer;
+    });
+}
 
-        if (!paused) {
+void Game::saveRecording()
+{
+    inputLog.finish(tickCount);
+
+    std::string error;
+    if (!inputLog.save(options.recordFile, error)) {
+        std::cerr << error << std::endl;
+    }
+}
+
+void Game::tick()
+{
+    Renderer::Scope bind(renderer);
+    Profiler::Scope cycle(profiler, Profiler::CYCLE);
+
+    if (!paused) {
+        {
+            Profiler::Scope phase(profiler, Profiler::UPDATE_PLAYERS);
             updatePlayers();
-            updateBombs();
+        }
+        {
+            Profiler::Scope phase(profiler, Profiler::UPDATE_TIMERS);
+            updateTimers();
+        }
+        {
+            Profiler::Scope phase(profiler, Profiler::LEVEL_TRANSITION);
             handleLevelTransition();
+        }
 
-            // draw updates
-            for (const auto& bomb : bombs) {
-                Point bp = bomb.getPosition();
-                int t = bomb.getTimer();
-                if (t >=TIMER_MIN_DIGIT && t <= TIMER_MAX_DIGIT) {
-                    screen.setCharAt(bp.getX(), bp.getY(), char('0' + t));
-                }
-            }
-            for (auto& player : players) {
-                player.draw();
-            }
-            
+        // draw updates (lights first: they may redraw cells under the players)
+        Profiler::Scope phase(profiler, Profiler::DRAW_PLAYERS);
+        for (auto& player : players) {
+            player.updateLight();
+        }
+        for (auto& player : players) {
+            player.draw();
         }
+    }
 
+    {
+        Profiler::Scope phase(profiler, Profiler::DRAW_LEGEND);
         drawLegend();
-        sleep_ms(GAME_CYCLE_DELAY_MS);
+    }
+    {
+        Profiler::Scope phase(profiler, Profiler::PRESENT);
+        renderer.present(); // one terminal write per game cycle
+    }
+    ++tickCount;
+}
+
+void Game::collectInput(std::chrono::steady_clock::time_point deadline)
+{// block on stdin until the deadline, keeping every key that arrives meanwhile
+    char buffer[INPUT_BUFFER_SIZE];
+
+    while (true) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (left <= 0) break;
+
+        int n = wait_for_input(buffer, INPUT_BUFFER_SIZE, (int)left);
+        if (n < 0) { // input closed: keep the pace without spinning
+            sleep_ms((int)left);
+            break;
+        }
+        pendingKeys.insert(pendingKeys.end(), buffer, buffer + n);
+    }
+}
+
+void Game::dispatchInput()
+{// all keys of the last cycle are applied before the simulation step
+    Profiler::Scope phase(profiler, Profiler::INPUT);
+    for (char key : pendingKeys) {
+        if (!running) break;
+        handleInput(key);
+    }
+    pendingKeys.clear();
+}
+
+void Game::run()
+{
+    if (!begin()) {
+        return;
+    }
+
+    scheduler.start();
+    while (running) {
+        int ticks = scheduler.due(); // more than one when catching up after an overrun
+        dispatchInput();
+        for (int i = 0; i < ticks && running; ++i) {
+            tick();
+        }
+        collectInput(scheduler.deadline());
     }
 
     cls();
+    writeTickStats();
+    writeProfile();
+    if (isRecording()) {
+        saveRecording();
+    }
+}
+
+void Game::writeTickStats() const
+{
+    if (options.tickStatsFile.empty()) return;
+
+    std::ofstream out(options.tickStatsFile);
+    if (!out) {
+        std::cerr << "Cannot write tick stats to " << options.tickStatsFile << std::endl;
+        return;
+    }
+    scheduler.writeReport(out);
+}
+
+void Game::writeProfile() const
+{
+    if (options.profileFile.empty() || !profiler.hasSamples()) return;
+
+    std::ofstream out(options.profileFile);
+    if (!out) {
+        std::cerr << "Cannot write profile to " << options.profileFile << std::endl;
+        return;
+    }
+    profiler.writeReport(out);
 }
 
 void Game::reset()
 {
     running = false;
     paused = false;
+    timers.clear();
     bombs.clear();
+    freeBombIds.clear();
+    pendingKeys.clear();
     players.clear(); // reset
 }
\ No newline at end of file
@@ -3,12 +3,20 @@
 #include "Player.h"
 #include "Legend.h"
 #include "Bomb.h"
+#include "Renderer.h"
+#include "TerminalSink.h"
+#include "TimerWheel.h"
+#include "TickScheduler.h"
+#include "GameOptions.h"
+#include "Profiler.h"
+#include "InputLog.h"
+#include "GameContext.h"
 #include <vector>
 #include <chrono>// for timing functions
 
 class Game {
 private:
-    static constexpr int GAME_CYCLE_DELAY_MS = 100; // 100 ms per game cycle
+    static constexpr int INPUT_BUFFER_SIZE = 64; // bytes taken from stdin per read
 
 	// player constants
     static constexpr int PLAYER1_INDEX = 0;
@@ -35,9 +43,6 @@ private:
     static constexpr int TIMER_MIN_DIGIT = 0;
     static constexpr int TIMER_MAX_DIGIT = 9;
 
-	// starting map index
-    static constexpr int STARTING_MAP_INDEX = 0;
-
 	// input keys
     static constexpr char PLAYER1_DROP_KEY_LOWER = 'e';
     static constexpr char PLAYER1_DROP_KEY_UPPER = 'E';
@@ -48,9 +53,21 @@ private:
     static constexpr char REVIVE_KEY_LOWER = 'r';
     static constexpr char REVIVE_KEY_UPPER = 'R';
 
+	// profiler toggle key
+    static constexpr char PROFILER_KEY_LOWER = 'p';
+    static constexpr char PROFILER_KEY_UPPER = 'P';
+
+    GameOptions options;
+    TickScheduler scheduler; // paces run() at options.tickRate
+    Profiler profiler; // per-phase cycle timings
+    InputLog inputLog; // keys and riddle answers, kept when options.recordFile is set
+    long long tickCount = 0; // game cycles run so far; stamps the recorded input
+
     std::vector<std::string> screenFiles;
     std::string initError;
 
+    TerminalSink terminalSink; // default output when no sink is given
+    Renderer renderer; // frame buffer presented once per game cycle
     Screen screen;
     std::vector<Player> players;
     Legend legend;
@@ -60,15 +77,23 @@ private:
     Game(const Game&) = delete;
     Game& operator=(const Game&) = delete;
 
-	std::chrono::steady_clock::time_point startTime; // time when level started
-	std::chrono::steady_clock::time_point pauseStartTime;// time when pause started
+	long long startTick = 0;      // tick the session started on; the legend clock counts game cycles, so a replay shows the same time
+	long long pauseStartTick = 0; // tick the pause started on
 	int lastLegendSeconds;  // last recorded seconds for legend update
 
-    std::vector<Bomb> bombs;
+    TimerWheel timers; // bomb countdowns, detonations and spring launch expiry
+    std::vector<Bomb> bombs; // indexed by bomb id; slots are reused after detonation
+    std::vector<int> freeBombIds;
+
+    std::vector<char> pendingKeys; // keys read while waiting for the next cycle
+
+    GameContext context; // session state handed to the players (refers to the members above)
 
     Point findSafeSpawn(int preferredX, int preferredY, int dx, int dy, char ch);
     void placeLegend();
     void spawnBombAt(int x, int y);
+    void drawBombTimer(int bombId, long long tick);
+    void detonateBomb(int bombId);
     void tryDropBomb(int playerIndex);
 	void processExplosion(const Point& center, int radius); // process bomb explosion effects
     void tryRevivePlayer();
@@ -78,13 +103,20 @@ private:
     void displayGameOverScreen(); // helper: display game over and wait for input
     void initializeGameSession(); // helper: setup players and initial game state
 
-    void handleInput(char key);
-    void updateBombs();
+	void updateTimers(); // advances the timer wheel and runs the events due this cycle
 	void updatePlayers(); // updates all players
+	void collectInput(std::chrono::steady_clock::time_point deadline); // wait for keys until deadline
+	void dispatchInput(); // handle every key collected since the last cycle
+    void writeTickStats() const; // lateness report to options.tickStatsFile, if set
+    void writeProfile() const; // phase report to options.profileFile, if anything was profiled
+    bool isRecording() const { return !options.recordFile.empty(); }
+    void startRecording();
+    void saveRecording();
     void drawLegend(); 
 
 public:
-    Game();
+    // sink: output backend (terminal when null); must outlive the Game
+    explicit Game(RenderSink* sink = nullptr, const GameOptions& gameOptions = GameOptions());
     void drawStatusLine();
     bool init();
     bool hasError() const 
@@ -103,4 +135,14 @@ public:
 
     void run();
     void reset();
+
+    // Single-step interface (used by run() and by headless drivers)
+    bool begin(); // init and set up the first level; false if the game can't start
+    void handleInput(char key);
+    void tick();  // one game cycle: simulation, redraw and present
+    bool isRunning() const { return running; }
+    long long getTickCount() const { return tickCount; }
+    bool isSoundEnabled() const { return context.soundEnabled; }
+    void setRiddleAnswerSource(RiddleAnswerSource source) { context.riddles.setAnswerSource(std::move(source)); }
+    void setObserver(GameObserver* observer) { context.observer = observer; }
 };
\ No newline at end of file
@@ -0,0 +1,222 @@
+#include "GameAssets.h"
+#include "LevelPack.h"
+#include "MappedFile.h"
+#include "console.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+
+// Switch rows keep the pack's flags byte as their state
+static_assert(EntityTable::SWITCH_ON == LevelPack::SWITCH_ON_FLAG, "switch state and pack flags must match");
+
+bool GameAssets::load(std::string& errorMessage) {
+    // One open and one mapping for the whole pack, whatever the number of levels.
+    // The sources aren't checked against it; game --pack rebuilds it after an edit.
+    MappedFile pack;
+    std::string packError;
+    if (pack.open(LevelPack::DEFAULT_FILE, packError)) {
+        return readPack(pack, LevelPack::DEFAULT_FILE, errorMessage);
+    }
+    return loadText(errorMessage);
+}
+
+bool GameAssets::loadText(std::string& errorMessage) {
+    screenFiles = findScreenFiles();
+    std::sort(screenFiles.begin(), screenFiles.end());
+    if (screenFiles.empty()) {
+        errorMessage = "No screen files found (adv-world*.screen)";
+        return false;
+    }
+
+    // Parse every map with a scratch screen; sessions only ever copy the results
+    auto parser = std::make_unique<Screen>();
+    levels.assign(screenFiles.size(), Screen::Level());
+    for (size_t i = 0; i < screenFiles.size(); ++i) {
+        if (!parser->loadMap(screenFiles[i])) {
+            errorMessage = parser->getLastError();
+            return false;
+        }
+        parser->saveLevel(levels[i]);
+    }
+
+    return riddles.load(errorMessage);
+}
+
+namespace {
+    // Bounds-checked view of a table inside the mapped pack
+    template <typename T>
+    const T* packTable(const MappedFile& file, std::uint32_t offset, std::uint32_t count) {
+        if (offset % alignof(T) != 0 || offset > file.size() ||
+            (file.size() - offset) / sizeof(T) < count) return nullptr;
+        return reinterpret_cast<const T*>(file.data() + offset);
+    }
+
+    void putString(std::string& strings, const std::string& s, std::uint32_t& offset, std::uint32_t& length) {
+        offset = (std::uint32_t)strings.size();
+        length = (std::uint32_t)s.size();
+        strings += s;
+    }
+
+    template <typename T>
+    void putTable(std::string& out, const std::vector<T>& table) {
+        if (!table.empty()) out.append(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(T));
+    }
+}
+
+bool GameAssets::loadPack(const std::string& filename, std::string& errorMessage) {
+    MappedFile file;
+    if (!file.open(filename, errorMessage)) return false;
+    return readPack(file, filename, errorMessage);
+}
+
+bool GameAssets::readPack(const MappedFile& file, const std::string& filename, std::string& errorMessage) {
+    // Tables are used in place; only the entity lists and strings are copied out
+    const LevelPack::Header* header = packTable<LevelPack::Header>(file, 0, 1);
+    if (!header || std::memcmp(header->magic, LevelPack::MAGIC, sizeof(LevelPack::MAGIC)) != 0) {
+        errorMessage = "Not a level pack: " + filename;
+        return false;
+    }
+    if (header->version != LevelPack::VERSION) {
+        errorMessage = "Unsupported level pack version: " + filename;
+        return false;
+    }
+
+    const auto* packLevels = packTable<LevelPack::Level>(file, header->levelsOffset, header->levelCount);
+    const auto* entities = packTable<LevelPack::Entity>(file, header->entitiesOffset, header->entityCount);
+    const auto* packRiddles = packTable<LevelPack::Riddle>(file, header->riddlesOffset, header->riddleCount);
+    const char* strings = packTable<char>(file, header->stringsOffset, header->stringsSize);
+    if (!packLevels || !entities || !packRiddles || !strings || header->levelCount == 0) {
+        errorMessage = "Truncated level pack: " + filename;
+        return false;
+    }
+    auto stringAt = [&](std::uint32_t offset, std::uint32_t length, std::string& out) {
+        if (offset > header->stringsSize || header->stringsSize - offset < length) return false;
+        out.assign(strings + offset, length);
+        return true;
+    };
+
+    screenFiles.assign(header->levelCount, std::string());
+    levels.assign(header->levelCount, Screen::Level());
+    for (std::uint32_t i = 0; i < header->levelCount; ++i) {
+        const LevelPack::Level& in = packLevels[i];
+        Screen::Level& level = levels[i];
+        if (!stringAt(in.nameOffset, in.nameLength, screenFiles[i]) ||
+            in.firstEntity > header->entityCount || header->entityCount - in.firstEntity < in.entityCount) {
+            errorMessage = "Corrupt level pack: " + filename;
+            return false;
+        }
+
+        for (int y = 0; y < Screen::MAX_Y; ++y) {
+            std::memcpy(level.board + Screen::boardIndex(0, y), in.board[y], Screen::MAX_X);
+        }
+        for (std::uint32_t e = in.firstEntity; e < in.firstEntity + in.entityCount; ++e) {
+            const LevelPack::Entity& entity = entities[e];
+            if (entity.x >= Screen::MAX_X || entity.y >= Screen::MAX_Y) {
+                errorMessage = "Corrupt level pack: " + filename;
+                return false;
+            }
+            std::uint16_t cell = (std::uint16_t)(entity.y * Screen::MAX_X + entity.x);
+            switch (entity.type) {
+            case LevelPack::KEY:      level.entities.add(cell, EntityKind::KEY); break;
+            case LevelPack::OBSTACLE: level.entities.add(cell, EntityKind::OBSTACLE); break;
+            case LevelPack::TORCH:    level.entities.add(cell, EntityKind::TORCH); break;
+            case LevelPack::SPRING:   level.entities.add(cell, EntityKind::SPRING); break;
+            case LevelPack::SWITCH:   level.entities.add(cell, EntityKind::SWITCH, entity.flags); break;
+            default:
+                errorMessage = "Corrupt level pack: " + filename;
+                return false;
+            }
+        }
+        level.legendPos = Point(in.legendX, in.legendY);
+        level.hasLegend = in.hasLegend != 0;
+        Screen::indexLevel(level);
+    }
+
+    RiddleBook book;
+    for (std::uint32_t i = 0; i < header->riddleCount; ++i) {
+        std::string question, answer;
+        if (!stringAt(packRiddles[i].questionOffset, packRiddles[i].questionLength, question) ||
+            !stringAt(packRiddles[i].answerOffset, packRiddles[i].answerLength, answer)) {
+            errorMessage = "Corrupt level pack: " + filename;
+            return false;
+        }
+        book.add(std::move(question), std::move(answer));
+    }
+    riddles.assign(book);
+    return true;
+}
+
+bool GameAssets::savePack(const std::string& filename, std::string& errorMessage) const {
+    std::vector<LevelPack::Level> packLevels(levels.size());
+    std::vector<LevelPack::Entity> entities;
+    std::vector<LevelPack::Riddle> packRiddles;
+    std::string strings;
+
+    auto packType = [](EntityKind kind) -> std::uint8_t {
+        switch (kind) {
+        case EntityKind::KEY:      return LevelPack::KEY;
+        case EntityKind::OBSTACLE: return LevelPack::OBSTACLE;
+        case EntityKind::TORCH:    return LevelPack::TORCH;
+        case EntityKind::SWITCH:   return LevelPack::SWITCH;
+        case EntityKind::SPRING:   break;
+        }
+        return LevelPack::SPRING;
+    };
+
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const Screen::Level& level = levels[i];
+        LevelPack::Level& out = packLevels[i];
+        std::memset(&out, 0, sizeof(out));
+        putString(strings, screenFiles[i], out.nameOffset, out.nameLength);
+
+        out.firstEntity = (std::uint32_t)entities.size();
+        const EntityTable& table = level.entities;
+        for (size_t e = 0; e < table.size(); ++e) {
+            std::uint8_t x = (std::uint8_t)(table.cell[e] % Screen::MAX_X);
+            std::uint8_t y = (std::uint8_t)(table.cell[e] / Screen::MAX_X);
+            std::uint8_t flags = table.kind[e] == EntityKind::SWITCH ? table.state[e] : 0;
+            entities.push_back({ packType(table.kind[e]), x, y, flags });
+        }
+        out.entityCount = (std::uint32_t)entities.size() - out.firstEntity;
+
+        out.legendX = (std::uint8_t)level.legendPos.getX();
+        out.legendY = (std::uint8_t)level.legendPos.getY();
+        out.hasLegend = level.hasLegend ? 1 : 0;
+        for (int y = 0; y < Screen::MAX_Y; ++y) {
+            std::memcpy(out.board[y], level.board + Screen::boardIndex(0, y), Screen::MAX_X);
+        }
+    }
+
+    for (const RiddleBook::Riddle& r : riddles.getAll()) {
+        LevelPack::Riddle out;
+        putString(strings, r.question, out.questionOffset, out.questionLength);
+        putString(strings, r.answer, out.answerOffset, out.answerLength);
+        packRiddles.push_back(out);
+    }
+
+    LevelPack::Header header;
+    std::memcpy(header.magic, LevelPack::MAGIC, sizeof(header.magic));
+    header.version = LevelPack::VERSION;
+    header.levelCount = (std::uint32_t)packLevels.size();
+    header.entityCount = (std::uint32_t)entities.size();
+    header.riddleCount = (std::uint32_t)packRiddles.size();
+    header.levelsOffset = sizeof(header);
+    header.entitiesOffset = header.levelsOffset + header.levelCount * (std::uint32_t)sizeof(LevelPack::Level);
+    header.riddlesOffset = header.entitiesOffset + header.entityCount * (std::uint32_t)sizeof(LevelPack::Entity);
+    header.stringsOffset = header.riddlesOffset + header.riddleCount * (std::uint32_t)sizeof(LevelPack::Riddle);
+    header.stringsSize = (std::uint32_t)strings.size();
+
+    std::string data(reinterpret_cast<const char*>(&header), sizeof(header));
+    putTable(data, packLevels);
+    putTable(data, entities);
+    putTable(data, packRiddles);
+    data += strings;
+
+    std::ofstream out(filename, std::ios::binary);
+    if (!out || !out.write(data.data(), (std::streamsize)data.size())) {
+        errorMessage = "Cannot write level pack: " + filename;
+        return false;
+    }
+    return true;
+}
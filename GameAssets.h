@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Riddle.h"
+#include "Screen.h"
+
+// Parsed screens and riddles read once and then shared read-only by any number of
+// game sessions (see GameOptions::assets). They come from the level pack when
+// Data/levels.pack exists, otherwise from the text files in Data/.
+class MappedFile;
+
+class GameAssets {
+    std::vector<std::string> screenFiles; // sorted, like Screen::loadScreenFiles()
+    std::vector<Screen::Level> levels;
+    RiddleBook riddles;
+
+    bool readPack(const MappedFile& file, const std::string& filename, std::string& errorMessage);
+
+public:
+    // Returns false with a message if a screen file or the riddles can't be read.
+    // Uses the level pack when there is one (rebuilt with game --pack after editing the text files).
+    bool load(std::string& errorMessage);
+    bool loadText(std::string& errorMessage);
+    bool loadPack(const std::string& filename, std::string& errorMessage);
+
+    // Writes everything loaded to a level pack (see LevelPack.h)
+    bool savePack(const std::string& filename, std::string& errorMessage) const;
+
+    const std::vector<std::string>& getScreenFiles() const { return screenFiles; }
+    const Screen::Level& getLevel(int index) const { return levels[index]; }
+    int getScreenCount() const { return (int)screenFiles.size(); }
+
+    // Sessions copy this so each keeps its own riddle progress
+    const RiddleBook& getRiddles() const { return riddles; }
+};
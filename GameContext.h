@@ -0,0 +1,37 @@
+#pragma once
+#include <vector>
+#include "Door.h"
+#include "Riddle.h"
+#include "GameObserver.h"
+#include "console.h"
+
+class Screen;
+class TimerWheel;
+class Player;
+
+// Mutable state of one game session.
+// Game owns it and hands it to its players; Door, Spring and Obstacle reach it through
+// the player they act on. Nothing of a session lives in globals, so several Game
+// objects can run side by side (each on its own thread, or interleaved on one).
+struct GameContext {
+    Screen& screen;
+    TimerWheel& timers;
+    std::vector<Player>& players;
+
+    DoorState doors;   // which doors have been opened
+    RiddleBook riddles; // loaded riddles and the next one to ask
+    bool soundEnabled = false;
+    GameObserver* observer = nullptr; // optional, not owned
+
+    GameContext(Screen& sessionScreen, TimerWheel& sessionTimers, std::vector<Player>& sessionPlayers)
+        : screen(sessionScreen), timers(sessionTimers), players(sessionPlayers)
+    {
+    }
+
+    GameContext(const GameContext&) = delete;
+    GameContext& operator=(const GameContext&) = delete;
+
+    void playSound(const char* eventName) const {
+        if (soundEnabled) ring_bell(eventName);
+    }
+};
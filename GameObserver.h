@@ -0,0 +1,17 @@
+#pragma once
+
+// Receives gameplay milestones of one session (the simulator gathers its statistics this way).
+// All callbacks run on the thread driving the Game; the defaults ignore the event.
+class GameObserver {
+public:
+    virtual ~GameObserver() = default;
+
+    // A map was entered (also at the start of the session)
+    virtual void onLevelStart(int /*map*/, long long /*tick*/) {}
+    // Both players went through a door on map; nextMap is where they are going
+    virtual void onLevelComplete(int /*map*/, int /*nextMap*/, long long /*tick*/) {}
+    // A player lost a life to a bomb explosion
+    virtual void onBombHit(int /*map*/, int /*playerIndex*/) {}
+    // A riddle prompt closed; canceled when it was dismissed without an answer
+    virtual void onRiddleAnswered(int /*map*/, bool /*correct*/, bool /*canceled*/) {}
+};
@@ -0,0 +1,22 @@
+#pragma once
+#include <string>
+
+class GameAssets;
+
+// Settings chosen on the command line and handed from main() through Menu to Game
+struct GameOptions {
+    static constexpr int DEFAULT_TICK_RATE = 10; // game cycles per second
+
+    int tickRate = DEFAULT_TICK_RATE;
+    int startMap = 0; // first level, as an index into the sorted screen files
+    bool colors = true;
+    bool sound = false;
+    bool keepRevealed = false; // hidden walls stay visible once a torch has lit them
+    const GameAssets* assets = nullptr; // preloaded screens and riddles shared between sessions (null: read Data/)
+    std::string tickStatsFile; // tick lateness report written here on exit (empty: off)
+
+    bool profile = false; // start with the phase profiler on (toggled in game with P)
+    std::string profileFile = "profile.txt"; // phase report written here on exit if anything was profiled
+
+    std::string recordFile; // input log for --replay written here on exit (empty: off)
+};
@@ -0,0 +1,38 @@
+#include "GridSink.h"
+#include "console.h"
+
+GridSink::GridSink() {
+    clear();
+}
+
+void GridSink::writeRun(int x, int y, const RenderCell* cells, int count) {
+    for (int i = 0; i < count; ++i) {
+        grid[y][x + i] = cells[i];
+    }
+}
+
+void GridSink::clear() {
+    for (int y = 0; y < HEIGHT; ++y) {
+        for (int x = 0; x < WIDTH; ++x) {
+            grid[y][x] = { ' ', static_cast<unsigned char>(Color::White) };
+        }
+    }
+}
+
+char GridSink::getCharAt(int x, int y) const {
+    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return ' ';
+    return grid[y][x].ch;
+}
+
+int GridSink::getColorAt(int x, int y) const {
+    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return static_cast<int>(Color::White);
+    return grid[y][x].color;
+}
+
+std::string GridSink::getRow(int y) const {
+    std::string row;
+    if (y < 0 || y >= HEIGHT) return row;
+    row.reserve(WIDTH);
+    for (int x = 0; x < WIDTH; ++x) row.push_back(grid[y][x].ch);
+    return row;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <string>
+#include "RenderSink.h"
+
+// In-memory copy of everything presented - lets tests inspect the rendered board
+class GridSink : public RenderSink {
+    RenderCell grid[HEIGHT][WIDTH];
+    int framesPresented = 0;
+
+public:
+    GridSink();
+
+    void writeRun(int x, int y, const RenderCell* cells, int count) override;
+    void endFrame() override { ++framesPresented; }
+    void clear() override;
+
+    char getCharAt(int x, int y) const;
+    int getColorAt(int x, int y) const;
+    std::string getRow(int y) const;
+    int getFramesPresented() const { return framesPresented; }
+};
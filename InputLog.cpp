@@ -0,0 +1,102 @@
+#include "InputLog.h"
+#include <fstream>
+#include <iterator>
+
+constexpr char InputLog::MAGIC[4];
+
+namespace {
+    void putVarint(std::string& out, unsigned long long value) {
+        while (value >= 0x80) {
+            out.push_back((char)((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back((char)value);
+    }
+
+    bool getVarint(const std::string& in, size_t& pos, unsigned long long& value) {
+        value = 0;
+        for (int shift = 0; pos < in.size() && shift < 64; shift += 7) {
+            unsigned char byte = (unsigned char)in[pos++];
+            value |= (unsigned long long)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+}
+
+bool InputLog::save(const std::string& filename, std::string& error) const {
+    std::string data(MAGIC, sizeof(MAGIC));
+    data.push_back((char)VERSION);
+    putVarint(data, (unsigned long long)header.tickRate);
+    putVarint(data, (unsigned long long)header.startMap);
+    putVarint(data, (unsigned long long)header.mapCount);
+    data.push_back((char)((header.sound ? 1 : 0) | (header.colors ? 2 : 0) | (header.keepRevealed ? 4 : 0)));
+
+    long long lastTick = 0;
+    for (const Entry& e : entries) {
+        putVarint(data, ((unsigned long long)(e.tick - lastTick) << 2) | (unsigned long long)e.kind);
+        data.push_back(e.key);
+        lastTick = e.tick;
+    }
+    if (endTick >= 0) {
+        putVarint(data, ((unsigned long long)(endTick - lastTick) << 2) | (unsigned long long)Kind::END);
+    }
+
+    std::ofstream out(filename, std::ios::binary);
+    if (!out || !out.write(data.data(), (std::streamsize)data.size())) {
+        error = "Cannot write input log: " + filename;
+        return false;
+    }
+    return true;
+}
+
+bool InputLog::load(const std::string& filename, std::string& error) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) {
+        error = "Cannot open input log: " + filename;
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    if (data.size() < sizeof(MAGIC) + 1 || data.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0) {
+        error = "Not an input log: " + filename;
+        return false;
+    }
+    if ((unsigned char)data[sizeof(MAGIC)] != VERSION) {
+        error = "Unsupported input log version: " + filename;
+        return false;
+    }
+
+    size_t pos = sizeof(MAGIC) + 1;
+    unsigned long long tickRate, startMap, mapCount;
+    if (!getVarint(data, pos, tickRate) || !getVarint(data, pos, startMap) ||
+        !getVarint(data, pos, mapCount) || pos >= data.size()) {
+        error = "Truncated input log header: " + filename;
+        return false;
+    }
+    unsigned char flags = (unsigned char)data[pos++];
+    header.tickRate = (int)tickRate;
+    header.startMap = (int)startMap;
+    header.mapCount = (int)mapCount;
+    header.sound = (flags & 1) != 0;
+    header.colors = (flags & 2) != 0;
+    header.keepRevealed = (flags & 4) != 0;
+
+    entries.clear();
+    endTick = -1;
+    long long tick = 0;
+    while (pos < data.size()) {
+        unsigned long long word;
+        if (!getVarint(data, pos, word)) break; // cut short: keep what was complete
+        tick += (long long)(word >> 2);
+
+        Kind kind = (Kind)(word & 3);
+        if (kind == Kind::END) {
+            endTick = tick;
+            break;
+        }
+        if (pos >= data.size()) break;
+        entries.push_back({ tick, kind, data[pos++] });
+    }
+    return true;
+}
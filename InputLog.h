@@ -0,0 +1,55 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Compact binary log of everything a game session read from the keyboard,
+// stamped with the game tick it was dispatched on, so the session can be replayed exactly.
+//
+// File layout: "CPAI", version byte, header fields, then one record per input:
+// varint((tickDelta << 2) | kind) followed by the key byte. An END record carries
+// the final tick and no key.
+class InputLog {
+public:
+    enum class Kind : unsigned char {
+        KEY = 0,           // passed to Game::handleInput()
+        RIDDLE_ANSWER = 1, // answer given to a riddle prompt
+        END = 2            // session ended on this tick
+    };
+
+    struct Entry {
+        long long tick;
+        Kind kind;
+        char key;
+    };
+
+    // Session settings needed to reproduce it
+    struct Header {
+        int tickRate = 0;
+        int startMap = 0;
+        int mapCount = 0; // screen files found when recording (sanity check)
+        bool sound = false;
+        bool colors = false;
+        bool keepRevealed = false;
+    };
+
+private:
+    static constexpr char MAGIC[4] = { 'C', 'P', 'A', 'I' };
+    static constexpr unsigned char VERSION = 1;
+
+    Header header;
+    std::vector<Entry> entries;
+    long long endTick = -1; // -1 when the recording was cut short
+
+public:
+    void setHeader(const Header& sessionHeader) { header = sessionHeader; }
+    const Header& getHeader() const { return header; }
+
+    void add(long long tick, Kind kind, char key) { entries.push_back({ tick, kind, key }); }
+    void finish(long long tick) { endTick = tick; }
+
+    const std::vector<Entry>& getEntries() const { return entries; }
+    long long getEndTick() const { return endTick; }
+
+    bool save(const std::string& filename, std::string& error) const;
+    bool load(const std::string& filename, std::string& error);
+};
@@ -21,13 +21,15 @@ bool Key::handleCollision(Player& player, Screen& screen) {
 
     if (canCollect(player))
     {
+        // collect() removes this key from the screen's list, so keep its position first
+        Point keyPos = position;
         collect(player, screen);
 
         // Move player to key position
         Point playerPos = player.getPosition();
         char bg = screen.getCharAt(playerPos);
         playerPos.draw(bg);
-        player.setInitPosition(position);
+        player.setInitPosition(keyPos);
         player.draw();
 
         return true;
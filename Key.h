@@ -5,7 +5,7 @@
 class Player;
 class Screen;
 
-class Key : public GameObject
+class Key final : public GameObject
 {
     Point position;
 
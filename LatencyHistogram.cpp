@@ -0,0 +1,88 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    int highestBit(uint64_t value) {
+        int bit = 0;
+        while (value >>= 1) ++bit;
+        return bit;
+    }
+}
+
+LatencyHistogram::LatencyHistogram() : counts(BUCKET_COUNT, 0) {}
+
+int LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < (uint64_t)EXACT_LIMIT) return (int)value;
+
+    int shift = highestBit(value) - (SUB_BUCKET_BITS - 1);
+    int sub = (int)(value >> shift) - HALF_BUCKETS;
+    return EXACT_LIMIT + (shift - 1) * HALF_BUCKETS + sub;
+}
+
+uint64_t LatencyHistogram::bucketLowest(int index) {
+    if (index < EXACT_LIMIT) return (uint64_t)index;
+
+    int offset = index - EXACT_LIMIT;
+    int shift = offset / HALF_BUCKETS + 1;
+    uint64_t sub = (uint64_t)(offset % HALF_BUCKETS + HALF_BUCKETS);
+    return sub << shift;
+}
+
+uint64_t LatencyHistogram::bucketHighest(int index) {
+    if (index < EXACT_LIMIT) return (uint64_t)index;
+
+    int shift = (index - EXACT_LIMIT) / HALF_BUCKETS + 1;
+    return bucketLowest(index) + ((uint64_t)1 << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    ++counts[bucketIndex(value)];
+    if (total == 0 || value < minValue) minValue = value;
+    if (value > maxValue) maxValue = value;
+    sum += value;
+    ++total;
+}
+
+void LatencyHistogram::reset() {
+    std::fill(counts.begin(), counts.end(), 0);
+    total = 0;
+    sum = 0;
+    minValue = 0;
+    maxValue = 0;
+}
+
+uint64_t LatencyHistogram::percentile(double percent) const {
+    if (total == 0) return 0;
+
+    uint64_t target = (uint64_t)std::ceil(percent / 100.0 * (double)total);
+    if (target < 1) target = 1;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += counts[i];
+        if (seen >= target) {
+            return std::min(bucketHighest(i), maxValue);
+        }
+    }
+    return maxValue;
+}
+
+void LatencyHistogram::writeSummary(std::ostream& out, const std::string& label) const {
+    out << label
+        << " count=" << total
+        << " min=" << minValue
+        << " mean=" << (uint64_t)std::llround(mean())
+        << " p50=" << percentile(50.0)
+        << " p90=" << percentile(90.0)
+        << " p99=" << percentile(99.0)
+        << " p99.9=" << percentile(99.9)
+        << " max=" << maxValue << '\n';
+}
+
+void LatencyHistogram::writeBuckets(std::ostream& out) const {
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        if (counts[i] == 0) continue;
+        out << bucketLowest(i) << ".." << bucketHighest(i) << ' ' << counts[i] << '\n';
+    }
+}
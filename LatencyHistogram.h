@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// HDR-style histogram of non-negative integer samples (typically microseconds).
+// Values below 2^SUB_BUCKET_BITS are counted exactly; above that every power of two
+// is split into 2^(SUB_BUCKET_BITS-1) linear buckets, so a reported percentile is
+// within ~3% of the true value. Recording is a couple of shifts and an increment.
+class LatencyHistogram {
+    static constexpr int SUB_BUCKET_BITS = 6;
+    static constexpr int EXACT_LIMIT = 1 << SUB_BUCKET_BITS;        // 64
+    static constexpr int HALF_BUCKETS = 1 << (SUB_BUCKET_BITS - 1); // 32 per power of two
+    static constexpr int BUCKET_COUNT = EXACT_LIMIT + (64 - SUB_BUCKET_BITS) * HALF_BUCKETS;
+
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+    uint64_t sum = 0;
+    uint64_t minValue = 0;
+    uint64_t maxValue = 0;
+
+    static int bucketIndex(uint64_t value);
+    static uint64_t bucketLowest(int index);
+    static uint64_t bucketHighest(int index);
+
+public:
+    LatencyHistogram();
+
+    void record(uint64_t value);
+    void reset();
+
+    uint64_t count() const { return total; }
+    uint64_t min() const { return minValue; }
+    uint64_t max() const { return maxValue; }
+    double mean() const { return total ? (double)sum / (double)total : 0.0; }
+
+    // Smallest bucket value that at least percent% of the samples are at or below
+    uint64_t percentile(double percent) const;
+
+    // One line: count, min, mean, p50/p90/p99/p99.9 and max
+    void writeSummary(std::ostream& out, const std::string& label) const;
+    // Non-empty buckets, one "lowest..highest count" line each
+    void writeBuckets(std::ostream& out) const;
+};
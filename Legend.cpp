@@ -2,7 +2,8 @@
 #include "utils.h"
 #include "Constants.h"
 #include "console.h"
-#include <iostream>
+#include "Renderer.h"
+#include <sstream>
 #include <iomanip> // for std::setw and std::setfill
 
 
@@ -37,34 +38,38 @@ void Legend::drawLegend(const Player& p1, const Player& p2, int gameTime)
     lastTime = gameTime;
 
 
+    Renderer& renderer = Renderer::active();
+    const int color = static_cast<int>(Color::White);
+
     if (changeTime) {// update game time display
-        gotoxy(x, y);
-        std::cout << "Time: " << std::setw(3) << std::setfill('0') << gameTime << "      ";
+        std::ostringstream line;
+        line << "Time: " << std::setw(3) << std::setfill('0') << gameTime << "      ";
+        renderer.putText(x, y, line.str(), color);
     }
    
     if (changeP1) {// update player 1 stats display
-        gotoxy(x, y + 1);
+        std::ostringstream line;
         if (p1.isAlive())
         {
-            std::cout << "P1: " << std::setw(3) << std::setfill('0') << p1.getScore()
+            line << "P1: " << std::setw(3) << std::setfill('0') << p1.getScore()
                 << " L:" << p1.getLives() << " [" << p1.getHeldItemChar() << "]                      ";
         }
         else {
-			std::cout << "P1 IS DEAD PRESS R TO REVIVE (100 SC)";
+			line << "P1 IS DEAD PRESS R TO REVIVE (100 SC)";
         }
+        renderer.putText(x, y + 1, line.str(), color);
     }
 
     if (changeP2) {// update player 2 stats display
-        gotoxy(x, y + 2);
+        std::ostringstream line;
         if (p2.isAlive()) {
-            std::cout << "P2: " << std::setw(3) << std::setfill('0') << p2.getScore()
+            line << "P2: " << std::setw(3) << std::setfill('0') << p2.getScore()
                 << " L:" << p2.getLives() << " [" << p2.getHeldItemChar() << "]                      ";
         }
         else {
-            std::cout << "P2 IS DEAD PRESS R TO REVIVE (100 SC)";
+            line << "P2 IS DEAD PRESS R TO REVIVE (100 SC)";
         }
+        renderer.putText(x, y + 2, line.str(), color);
     }
-
-    setTextColor(static_cast<int>(Color::White)); 
 }
 
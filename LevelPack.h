@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#if __has_include(<bit>)
+#include <bit>
+#endif
+#include "Screen.h"
+
+// On-disk layout of a level pack (game --pack), read in place from a mapped file.
+// All integers are little-endian and every record is 4-byte aligned, so the tables
+// can be used straight from the mapping:
+//
+//   Header | Level[levelCount] | Entity[entityCount] | Riddle[riddleCount] | strings
+//
+// Offsets are from the start of the file; string offsets are into the string table.
+// The tables are written and read in host byte order, which must be little-endian
+#if defined(__cpp_lib_endian)
+static_assert(std::endian::native == std::endian::little, "level packs require a little-endian target");
+#elif defined(__BYTE_ORDER__)
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "level packs require a little-endian target");
+#endif
+
+namespace LevelPack {
+    constexpr char MAGIC[4] = { 'C', 'P', 'A', 'L' };
+    constexpr std::uint32_t VERSION = 1;
+    constexpr const char* DEFAULT_FILE = "Data/levels.pack";
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t levelCount;
+        std::uint32_t entityCount;
+        std::uint32_t riddleCount;
+        std::uint32_t levelsOffset;
+        std::uint32_t entitiesOffset;
+        std::uint32_t riddlesOffset;
+        std::uint32_t stringsOffset;
+        std::uint32_t stringsSize;
+    };
+
+    struct Level {
+        std::uint32_t nameOffset;  // source file name
+        std::uint32_t nameLength;
+        std::uint32_t firstEntity; // range in the entity table
+        std::uint32_t entityCount;
+        std::uint8_t legendX;
+        std::uint8_t legendY;
+        std::uint8_t hasLegend;
+        std::uint8_t reserved;
+        char board[Screen::MAX_Y][Screen::MAX_X]; // already parsed: no 'L', no switch digits
+    };
+
+    enum EntityType : std::uint8_t { KEY = 1, OBSTACLE, TORCH, SWITCH, SPRING };
+    constexpr std::uint8_t SWITCH_ON_FLAG = 0x80; // Entity::flags; low bits hold the switch group
+
+    struct Entity {
+        std::uint8_t type;
+        std::uint8_t x;
+        std::uint8_t y;
+        std::uint8_t flags;
+    };
+
+    struct Riddle {
+        std::uint32_t questionOffset;
+        std::uint32_t questionLength;
+        std::uint32_t answerOffset;
+        std::uint32_t answerLength;
+    };
+
+    static_assert(sizeof(Header) == 40, "level pack header must have no padding");
+    static_assert(sizeof(Level) == 20 + Screen::MAX_Y * Screen::MAX_X, "level record must have no padding");
+    static_assert(sizeof(Level) % 4 == 0 && sizeof(Entity) == 4 && sizeof(Riddle) == 16, "records must stay aligned");
+}
@@ -0,0 +1,70 @@
+#include "LevelPrefetcher.h"
+#include <algorithm>
+
+LevelPrefetcher::~LevelPrefetcher() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+        queue.clear();
+    }
+    jobQueued.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+void LevelPrefetcher::request(int index, const std::string& filename) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (parsing == index || ready.count(index)) return;
+        for (const Job& job : queue) {
+            if (job.index == index) return;
+        }
+        queue.push_back({ index, filename });
+        if (!worker.joinable()) worker = std::thread([this] { run(); });
+    }
+    jobQueued.notify_one();
+}
+
+std::unique_ptr<const Screen::Level> LevelPrefetcher::take(int index) {
+    std::unique_lock<std::mutex> guard(lock);
+    jobFinished.wait(guard, [&] { return parsing != index; });
+
+    auto found = ready.find(index);
+    if (found != ready.end()) {
+        std::unique_ptr<const Screen::Level> level = std::move(found->second);
+        ready.erase(found);
+        return level;
+    }
+
+    // Not started yet: the caller parses it now, faster than waiting behind other jobs
+    queue.erase(std::remove_if(queue.begin(), queue.end(),
+        [index](const Job& job) { return job.index == index; }), queue.end());
+    return nullptr;
+}
+
+void LevelPrefetcher::run() {
+    // Scratch screen used only by this thread; heap-allocated because Screen is large
+    auto parser = std::make_unique<Screen>();
+
+    std::unique_lock<std::mutex> guard(lock);
+    for (;;) {
+        jobQueued.wait(guard, [this] { return stopping || !queue.empty(); });
+        if (stopping) return;
+
+        Job job = std::move(queue.front());
+        queue.pop_front();
+        parsing = job.index;
+        guard.unlock();
+
+        // File I/O and parsing happen outside the lock
+        std::unique_ptr<Screen::Level> level;
+        if (parser->loadMap(job.filename)) {
+            level = std::make_unique<Screen::Level>();
+            parser->saveLevel(*level);
+        }
+
+        guard.lock();
+        if (level) ready[job.index] = std::move(level);
+        parsing = -1;
+        jobFinished.notify_all();
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Screen.h"
+
+// Parses screen files on a background thread so that entering a level that was
+// requested earlier only has to pick up the finished result (see Screen::setMap).
+// The thread is started by the first request and stopped by the destructor.
+class LevelPrefetcher {
+    struct Job {
+        int index;
+        std::string filename;
+    };
+
+    std::mutex lock;
+    std::condition_variable jobQueued;
+    std::condition_variable jobFinished;
+    std::deque<Job> queue;
+    std::map<int, std::unique_ptr<const Screen::Level>> ready;
+    int parsing = -1; // index being parsed right now
+    bool stopping = false;
+    std::thread worker;
+
+    void run();
+
+public:
+    LevelPrefetcher() = default;
+    ~LevelPrefetcher();
+
+    LevelPrefetcher(const LevelPrefetcher&) = delete;
+    LevelPrefetcher& operator=(const LevelPrefetcher&) = delete;
+
+    // Queue a level unless it is already queued, being parsed or ready
+    void request(int index, const std::string& filename);
+
+    // The parsed level, waiting if it is being parsed right now. Returns null if the
+    // level was never requested, is still queued (it is dropped) or failed to load.
+    std::unique_ptr<const Screen::Level> take(int index);
+};
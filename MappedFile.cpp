@@ -0,0 +1,74 @@
+#include "MappedFile.h"
+#include "console.h"
+#ifndef PLATFORM_WINDOWS
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+bool MappedFile::open(const std::string& filename, std::string& error) {
+    close();
+#ifdef PLATFORM_WINDOWS
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        error = "Cannot open file: " + filename;
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        error = "Empty or unreadable file: " + filename;
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        error = "Cannot map file: " + filename;
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    bytes = static_cast<const unsigned char*>(view);
+    length = (size_t)fileSize.QuadPart;
+#else
+    int file = ::open(filename.c_str(), O_RDONLY);
+    if (file < 0) {
+        error = "Cannot open file: " + filename;
+        return false;
+    }
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size == 0) {
+        ::close(file);
+        error = "Empty or unreadable file: " + filename;
+        return false;
+    }
+    void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (view == MAP_FAILED) {
+        ::close(file);
+        error = "Cannot map file: " + filename;
+        return false;
+    }
+    fd = file;
+    bytes = static_cast<const unsigned char*>(view);
+    length = (size_t)info.st_size;
+#endif
+    return true;
+}
+
+void MappedFile::close() {
+    if (!bytes) return;
+#ifdef PLATFORM_WINDOWS
+    UnmapViewOfFile(bytes);
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    fileHandle = mappingHandle = nullptr;
+#else
+    munmap(const_cast<unsigned char*>(bytes), length);
+    ::close(fd);
+    fd = -1;
+#endif
+    bytes = nullptr;
+    length = 0;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <string>
+#include <cstddef>
+
+// A whole file mapped read-only into memory (mmap / MapViewOfFile).
+// The mapping lives until the object is destroyed or close() is called.
+class MappedFile {
+    const unsigned char* bytes = nullptr;
+    size_t length = 0;
+    void* fileHandle = nullptr;    // Windows
+    void* mappingHandle = nullptr; // Windows
+    int fd = -1;                   // POSIX
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    // Returns false with a message if the file can't be opened or mapped
+    bool open(const std::string& filename, std::string& error);
+    void close();
+
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
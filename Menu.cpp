@@ -39,7 +39,7 @@ void Menu::displayMainMenu()
     setTextColor(Color::White);
     cout << "(1) Start game (Colors)\n";
     cout << "(2) Start game (No Colors)\n";
-    cout << "(3) Toggle Sound [" << (isSoundEnabled() ? "ON" : "OFF") << "]\n";
+    cout << "(3) Toggle Sound [" << (options.sound ? "ON" : "OFF") << "]\n";
     cout << "(8) Instructions\n";
     cout << "(9) EXIT\n\n";
     cout << "Choice: ";
@@ -58,10 +58,10 @@ void Menu::handleChoice(char choice)
     }
     else if (choice == '3')
     {
-        setSoundEnabled(!isSoundEnabled());
+        options.sound = !options.sound;
         clrscr();
         setTextColor(Color::Yellow);
-        cout << "Sound is now " << (isSoundEnabled() ? "ON" : "OFF") << endl;
+        cout << "Sound is now " << (options.sound ? "ON" : "OFF") << endl;
         sleep_ms(GameConstants::SOUND_FEEDBACK_DELAY_MS);
     }
     else if (choice == '8')
@@ -91,7 +91,8 @@ void Menu::printInstructions()
     cout << "SOUND CONTROL:\n";
     setTextColor(Color::White);
     cout << "Press 1 during gameplay to turn sound ON - Sound[1]\n";
-    cout << "Press 0 during gameplay to turn sound OFF - Sound[0]\n\n";
+    cout << "Press 0 during gameplay to turn sound OFF - Sound[0]\n";
+    cout << "Press P during gameplay to toggle the profiler (saved to profile.txt)\n\n";
 
     cout << "Press any key to return to the main menu.\n";
 
@@ -101,8 +102,8 @@ void Menu::printInstructions()
 
 void Menu::launchGame(bool enableColor)
 {
-    setColorMode(enableColor);
-    Game game;
+    options.colors = enableColor;
+    Game game(nullptr, options);
     if (!game.init())
     {
         showErrorMessage(game.getError());
@@ -110,4 +111,12 @@ void Menu::launchGame(bool enableColor)
     }
 
     game.run();
+    options.sound = game.isSoundEnabled(); // keep an in-game toggle for the next game
+}
+
+void Menu::setTextColor(Color c) const
+{
+    if (options.colors) {
+        set_color(c);
+    }
 }
@@ -1,7 +1,13 @@
 #pragma once
+#include "GameOptions.h"
+#include "console.h"
 
 class Menu {
+    GameOptions options; // passed on to every game started from the menu
+
 public:
+    explicit Menu(const GameOptions& gameOptions = GameOptions()) : options(gameOptions) {}
+
     void run();
 
 private:
@@ -9,4 +15,5 @@ private:
     void handleChoice(char choice);
     void printInstructions();
     void launchGame(bool enableColor);
+    void setTextColor(Color c) const; // no-op when colors are off
 };
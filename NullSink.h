@@ -0,0 +1,9 @@
+#pragma once
+#include "RenderSink.h"
+
+// Drops all output - runs the game headless at full simulation speed
+class NullSink : public RenderSink {
+public:
+    void writeRun(int, int, const RenderCell*, int) override {}
+    void clear() override {}
+};
@@ -3,6 +3,7 @@
 #include "Screen.h"
 #include "Direction.h"
 #include "Constants.h"
+#include "GameContext.h"
 #include <vector>
 
 using namespace GameConstants; // using namespace to avoid prefixing constants
@@ -79,11 +80,11 @@ int Obstacle::calculatePushForce(const Player& player, Direction pushDir, const
     int behindY = playerPos.getY() - dy;
 
     // Check for other players at that position
-    if (Player::allPlayers && Player::totalPlayers > 1)
+    if (player.context)
     {
-        for (int i = 0; i < Player::totalPlayers; ++i)
+        for (const Player& otherPlayer : player.context->players)
         {
-            Player* other = &Player::allPlayers[i];
+            const Player* other = &otherPlayer;
             if (other == &player) continue;
             if (!other->isActive()) continue;
 
@@ -122,7 +123,7 @@ bool Obstacle::canBePushed(int force, Direction dir, const Screen& screen) const
     Point cur = position;
     int obstacleSize = 0;
 
-	while (screen.getCharAt(cur) == OBSTACLE) //count all obstacles forming this group
+	while (screen.charAtUnchecked(cur) == OBSTACLE) //count all obstacles forming this group
     {
         obstacleSize++;
         cur.setX(cur.getX() + dx);
@@ -133,7 +134,7 @@ bool Obstacle::canBePushed(int force, Direction dir, const Screen& screen) const
     if (obstacleSize > force) return false;
 
 	// Check if destination (after all obstacles) is empty
-	char destChar = screen.getCharAt(cur);
+	char destChar = screen.charAtUnchecked(cur);
     if (destChar != EMPTY) return false;
 
     return true;
@@ -153,13 +154,12 @@ void Obstacle::push(Direction dir, Screen& screen) // push the obstacle in the s
     }
 
     // collect all obstacles in the chain before modifying the screen
-    std::vector<Obstacle*> obstacleChain;
+    std::vector<Point> obstacleChain;
     Point cur = position;
     while (screen.getCharAt(cur) == OBSTACLE) // count obstacles in the push direction
     {
-        Obstacle* obs = screen.getObstacleAt(cur);
-        if (obs) {
-            obstacleChain.push_back(obs);
+        if (screen.hasObstacleAt(cur)) {
+            obstacleChain.push_back(cur);
         }
         cur.setX(cur.getX() + dx);
         cur.setY(cur.getY() + dy);
@@ -167,6 +167,7 @@ void Obstacle::push(Direction dir, Screen& screen) // push the obstacle in the s
 
     int blockLen = static_cast<int>(obstacleChain.size());
 
+    Screen::Batch batch(screen); // each cell of the chain is redrawn once
 	for (int i = 0; i < blockLen; i++) // move obstacles one by one
     {
         Point dest = cur;
@@ -181,10 +182,10 @@ void Obstacle::push(Direction dir, Screen& screen) // push the obstacle in the s
         screen.setCharAt(src, EMPTY);
     }
 
-    for (size_t i = 0; i < obstacleChain.size(); i++) {// update obstacle positions
-        int oldX = obstacleChain[i]->position.getX();
-        int oldY = obstacleChain[i]->position.getY();
-        obstacleChain[i]->position.setX(oldX + dx);
-        obstacleChain[i]->position.setY(oldY + dy);
+    // update obstacle positions, farthest first so the entity index never has two obstacles on one cell
+    for (int i = static_cast<int>(obstacleChain.size()) - 1; i >= 0; i--) {
+        Point oldPos = obstacleChain[i];
+        Point newPos(oldPos.getX() + dx, oldPos.getY() + dy);
+        screen.moveObstacle(oldPos, newPos);
     }
 }
\ No newline at end of file
@@ -6,7 +6,7 @@
 class Player;
 class Screen;
 
-class Obstacle : public GameObject {
+class Obstacle final : public GameObject {
     Point position;
 
 public:
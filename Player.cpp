@@ -4,7 +4,8 @@
 #include "Constants.h"
 #include "Spring.h"      // For Spring::updateLaunch()
 #include "GameObject.h"  // For polymorphic object access
-#include "Door.h"        // For Door::isOpen/setOpen 
+#include "Door.h"
+#include "GameContext.h" // For the other players, door state and sound
 #include <cstring>
 #include <cctype>
 #include <cmath>
@@ -17,21 +18,14 @@
 
 using namespace GameConstants;
 
-Player* Player::allPlayers = nullptr;
-int Player::totalPlayers = 0;
-
 void Player::resetDoorKeys() { keysCollectedCounter = 0; } // reset collected door keys
 
-void Player::registerPlayers(Player* array, int count) { // register all players
-    allPlayers = array;
-    totalPlayers = count;
-}
-
-Player::Player(const Point& point, const char(&the_keys)[NUM_KEYS + 1], Screen* theScreen, bool alive)
-    : screen(theScreen), lives(alive ? 3 : 0), activePlayer(alive)
+Player::Player(const Point& point, const char(&the_keys)[NUM_KEYS + 1], GameContext* gameContext, int playerIndex, bool alive)
+    : lives(alive ? 3 : 0), index(playerIndex), context(gameContext), screen(gameContext ? &gameContext->screen : nullptr), activePlayer(alive)
 {// initialize position and keys
     for (auto& p : body) p = point;
     std::memcpy(keys, the_keys, NUM_KEYS * sizeof(keys[0]));
+    updateOccupancy();
 
     spring.reset(); // reset spring state
 }
@@ -45,30 +39,42 @@ void Player::draw() {// draw player on screen
 
 
 
-bool Player::isBlockedByOtherPlayer(const Point& p) const { // check collision with other players
-    if (!allPlayers || totalPlayers <= 1) return false;
+void Player::updateLight() {
+    if (!screen) return;
+
+    // Entering a map rebuilds the light map without this player's light
+    if (lightOn && lightGeneration != screen->getLightGeneration()) lightOn = false;
 
-    for (int i = 0; i < totalPlayers; ++i) {
-        Player* other = &allPlayers[i];
-        if (other == this || !other->isActive()) continue;
+    bool onGameOverScreen = screen->getCurrentMap() == screen->getNumScreens() - 1;
+    bool wanted = heldItem == ItemType::TORCH && activePlayer && isAlive() && !onGameOverScreen;
+    Point center(body[0].getX(), body[0].getY());
 
-        if (other->body[0].getX() == p.getX() && other->body[0].getY() == p.getY()) {
-            return true;
+    if (lightOn && wanted) {
+        if (center.getX() != lightCenter.getX() || center.getY() != lightCenter.getY()) {
+            screen->moveLight(lightCenter, center);
+            lightCenter = center;
         }
     }
-    return false;
+    else if (lightOn) {
+        screen->removeLight(lightCenter);
+        lightOn = false;
+    }
+    else if (wanted) {
+        screen->addLight(center);
+        lightCenter = center;
+        lightOn = true;
+        lightGeneration = screen->getLightGeneration();
+    }
+}
+
+void Player::playSound(const char* eventName) const {
+    if (context) context->playSound(eventName);
 }
 
-void Player::performMoveVisuals(const Point& oldPos, const Point& newPos) // perform visual updates for movement
+void Player::performMoveVisuals(const Point& oldPos) // perform visual updates for movement
 {
-    if (heldItem == ItemType::TORCH) {
-        // updte torch for light effect
-        screen->updateTorchLocation(oldPos, newPos, Torch::RADIUS);
-    }
-    else {
-        // delete normally
-        screen->drawCharOnly(oldPos.getX(), oldPos.getY());
-    }
+    // a held torch's light follows in updateLight()
+    screen->drawCharOnly(oldPos.getX(), oldPos.getY());
     // draw player at new position
     body[0].draw();
 }
@@ -87,7 +93,7 @@ void Player::move() {
     if (spring.energy > 0) {
         Point next = body[0];
         next.move();
-        char nextChar = screen->getCharAt(next);
+        char nextChar = screen->charAtUnchecked(next);
 
         // Release if not moving onto another spring
         if (nextChar != SPRING) {
@@ -104,18 +110,18 @@ void Player::move() {
         return;
     }
 
-    char nextChar = screen->getCharAt(next);
+    // One read of the destination cell answers every question below
+    CellProbe cell = screen->probe(next);
+    char nextChar = cell.glyph;
 
     // Check collisions with other players
-    if (nextChar == PLAYER_1 || nextChar == PLAYER_2) return;
-    if (isBlockedByOtherPlayer(next)) return;
+    if (cell.players & ~Screen::occupantBit(index)) return;
     // Block movement into the legend area
-    if (screen->isLegendArea(next)) return;
+    if (cell.is(CellProbe::LEGEND)) return;
 
-    GameObject* obj = screen->getObjectAt(next);// polymorphic object access
-    if (obj) {
-        // Object handles its own collision logic - NO dynamic_cast needed!
-        if (obj->handleCollision(*this, *screen)) {
+    if (cell.entity) {
+        // The entity handles its own collision logic (static dispatch on its type)
+        if (screen->collide(cell.entity, *this)) {
             return;  // Object handled the collision (e.g., pushed obstacle, player moved)
         }
         // Object blocked movement (e.g., unpushable obstacle) - stop player
@@ -125,25 +131,32 @@ void Player::move() {
     }
 
     // Special cases not yet refactored to GameObject pattern
-    if (processBombPickup(next, nextChar)) return;
-    if (processDoorEntry(next, nextChar)) return;
-    if (processRiddle(next, nextChar)) return;
+    switch (Tiles::of(nextChar).handler) {
+    case Tiles::Handler::BOMB:
+        if (processBombPickup(next, nextChar)) return;
+        break;
+    case Tiles::Handler::DOOR:
+        if (processDoorEntry(next, nextChar)) return;
+        break;
+    case Tiles::Handler::RIDDLE:
+        if (processRiddle(next, nextChar)) return;
+        break;
+    default:
+        break;
+    }
 
     // Hit wall so stop movement
-    if (nextChar == WALL || nextChar == WALL_X) {
+    if (cell.is(CellProbe::SOLID)) {
         body[0].setDirection(Direction::STAY);
         body[0].draw();
-
-        // Update lighting even when standing still
-        if (heldItem == ItemType::TORCH)
-            screen->refreshArea(body[0].getX(), body[0].getY(), Torch::RADIUS, true);
     }
     // Normal move
     else {
         Point oldPos = body[0];
         body[0] = next;
+        updateOccupancy();
 
-        performMoveVisuals(oldPos, body[0]);
+        performMoveVisuals(oldPos);
     }
 }
 
@@ -158,8 +171,14 @@ void Player::handleKeyPressed(char key_pressed) {// handle movement key press
     }
 }
 
+void Player::updateOccupancy() {
+    if (!screen) return;
+    screen->setOccupant(index, body[0], activePlayer);
+}
+
 void Player::setInitPosition(Point p) {
     body[0].set(p.getX(), p.getY());
+    updateOccupancy();
     spring.reset(); // reset spring
 }
 
@@ -172,6 +191,7 @@ void Player::moveToPositionPreserveSpring(const Point& newPos)
 
 void Player::resetAfterLevel() { // reset player state after level
     activePlayer = true;
+    updateOccupancy();
     lastDoorPassed = -1;
     resetDoorKeys();
     body[0].setDirection(Direction::STAY);
@@ -191,6 +211,7 @@ void Player::loseLife() {// lose a life and handle death
     if (lives > 0) --lives;
     if (lives == 0) {
         activePlayer = false; // player is dead
+        updateOccupancy();
         body[0].draw(EMPTY); // erase player from screen
     }
 }
@@ -245,7 +266,8 @@ void Player::disposeElement()
         heldItem = ItemType::NONE;
         screen->setCharAt(body[0], TORCH);
         screen->addTorch(body[0]);
-        screen->refreshArea(body[0].getX(), body[0].getY(), Torch::RADIUS);
+        // the dropped torch keeps lighting this spot; the held light goes in updateLight()
+        screen->addLight(body[0]);
         return;
     }
 
@@ -285,6 +307,7 @@ bool Player::processBombPickup(const Point& next, char nextChar)
     char bg = screen->getCharAt(body[0]);
     body[0].draw(bg);
     body[0] = next;
+    updateOccupancy();
     body[0].draw();
 
     return true;
@@ -297,8 +320,8 @@ bool Player::processDoorEntry(const Point& next, char nextChar)
     int doorIndex = (nextChar - DOOR_START);
     if (doorIndex < 0 || doorIndex >= NUM_DOOR_KEYS) return false;
 
-    // Delegate to Door class for state management
-    bool isOpen = Door::isOpen(nextChar);
+    // Door state is kept per session
+    bool isOpen = context && context->doors.isOpen(nextChar);
 
     // Check if switches are required and all are ON
     int switchGroup = screen->getDoorSwitchGroup(doorIndex + 1);
@@ -314,7 +337,7 @@ bool Player::processDoorEntry(const Point& next, char nextChar)
     {
         keysCollectedCounter--;
         heldItem = ItemType::NONE;
-        Door::setOpen(nextChar, true);
+        if (context) context->doors.setOpen(nextChar, true);
 
         addScore(SCORE_DOOR_PASS);
         lastDoorPassed = doorIndex;
@@ -4,6 +4,7 @@
 
 // Forward declarations
 class Spring;
+struct GameContext;
 class Obstacle;
 
 class Player {
@@ -21,7 +22,14 @@ class Player {
     int torchCollectedCounter = 0;
     int score = 0;
     int lives = 3;
-    Screen* screen = nullptr;
+    int index = -1; // slot in the session's players; its Screen::occupantBit marks where it stands
+    GameContext* context = nullptr; // session state shared with the other players
+    Screen* screen = nullptr;       // context->screen
+
+    // where this player's held torch light is on the screen's light map
+    Point lightCenter;
+    bool lightOn = false;
+    int lightGeneration = -1;
 
     // tracks which door we exited from
     int lastDoorPassed = -1;
@@ -41,7 +49,7 @@ class Player {
         int energy = 0;
         int dx = 0;
         int dy = 0;
-        int launch_turns = 0;
+        bool launching = false; // cleared by the scheduled launch expiry or a collision
         int launch_speed = 0;
         int launch_dx = 0;
         int launch_dy = 0;
@@ -52,9 +60,12 @@ class Player {
 
     SpringState spring;
 
+    // Keeps the screen's occupant map in step with position and active state
+    void updateOccupancy();
+    unsigned launchGeneration = 0; // survives spring.reset() so stale expiry events are ignored
+
     // Helper functions for clean logic
-    bool isBlockedByOtherPlayer(const Point& p) const;
-    void performMoveVisuals(const Point& oldPos, const Point& newPos);
+    void performMoveVisuals(const Point& oldPos);
 
     // Special cases not yet refactored (Riddle, Bomb, Door)
     bool processDoorEntry(const Point& next, char nextChar);
@@ -62,13 +73,12 @@ class Player {
     bool processRiddle(const Point& next, char nextChar);
     void handleRiddle(const Point& riddlePos);
 
-    static Player* allPlayers;
-    static int totalPlayers;
+    void playSound(const char* eventName) const;
 
 public:
     // Constructors
     Player() = default;
-    Player(const Point& point, const char(&the_keys)[NUM_KEYS + 1], Screen* theScreen, bool alive = true);
+    Player(const Point& point, const char(&the_keys)[NUM_KEYS + 1], GameContext* gameContext, int playerIndex, bool alive = true);
 
     // Delete copy (vector can't copy)
     Player(const Player&) = delete;
@@ -85,12 +95,14 @@ public:
     int getLastDoorPassed() const { return lastDoorPassed; }
     char getHeldItemChar() const;
     Point getPosition() const { return body[0]; }
+    int getIndex() const { return index; }
     bool isAlive() const { return (lives > 0); }
     bool isActive() const { return activePlayer; }
-    void setActive(bool active) { activePlayer = active; }
+    void setActive(bool active) { activePlayer = active; updateOccupancy(); }
 
     // Drawing
     void draw();
+    void updateLight(); // move the held torch's light to the player; Game calls it before drawing
     void draw(char c) { body[0].draw(c); }
 
     // Movement and input
@@ -117,7 +129,6 @@ public:
     void moveToPositionPreserveSpring(const Point& newPos);
 
     void resetAfterLevel();
-    static void registerPlayers(Player* array, int count);
 
     // Score and lives
     void addScore(int amount) { score += amount; }
@@ -130,6 +141,7 @@ public:
         if (!isAlive()) {
             lives = 1;
             activePlayer = true;
+            updateOccupancy();
         }
     }
 
@@ -3,25 +3,13 @@
 #include "utils.h"
 #include "console.h"
 #include "Direction.h"
-#include <iostream>
+#include "Renderer.h"
+#include "TileTable.h"
 
 // Choose color according to the character on the screen
 static int colorForChar(char c)
 {
-    switch (c) {
-    case '#': return static_cast<int>(Color::DarkGrey);      // wall
-    case 'S': return static_cast<int>(Color::Yellow);        // spring
-    case '*': return static_cast<int>(Color::LightRed);      // obstacle
-    case 'k': return static_cast<int>(Color::LightCyan);     // key
-    case '?': return static_cast<int>(Color::LightMagenta);  // riddle
-    case '1': case '2': case '3':
-    case '4': case '5': case '6':
-    case '7': case '8': case '9':   // doors
-        return static_cast<int>(Color::LightBlue);
-    case '$': return static_cast<int>(Color::LightGreen);    // player 1
-    case '&': return static_cast<int>(Color::LightCyan);     // player 2
-    default:  return static_cast<int>(Color::White);
-    }
+    return Tiles::of(c).color;
 }
 
 Point::Point(int x, int y, int diff_x, int diff_y, char ch)
@@ -30,18 +18,11 @@ Point::Point(int x, int y, int diff_x, int diff_y, char ch)
 }
 
 void Point::draw(char c) const {
-    gotoxy(x, y);
-
     // if c==0 → draw the point's own char; otherwise draw c
     char toPrint = (c == 0 ? ch : c);
 
-    int color = colorForChar(toPrint);
-    setTextColor(color);
-
-    std::cout << toPrint;
-    std::cout.flush();
-
-    setTextColor(static_cast<int>(Color::White)); // back to default so other prints are normal
+    // written into the frame buffer, shown on the next Renderer::present()
+    Renderer::active().putChar(x, y, toPrint, colorForChar(toPrint));
 }
 
 void Point::move() {
@@ -0,0 +1,35 @@
+#include "Profiler.h"
+#include <iomanip>
+
+namespace {
+    const char* const PHASE_NAMES[Profiler::PHASE_COUNT] = {
+        "input", "updatePlayers", "updateTimers", "levelTransition",
+        "drawPlayers", "drawLegend", "present", "cycle"
+    };
+}
+
+const char* Profiler::phaseName(Phase phase) {
+    return PHASE_NAMES[phase];
+}
+
+bool Profiler::hasSamples() const {
+    for (const auto& histogram : phases) {
+        if (histogram.count() > 0) return true;
+    }
+    return false;
+}
+
+void Profiler::record(Phase phase, Clock::duration elapsed) {
+    phases[phase].record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+void Profiler::writeReport(std::ostream& out) const {
+    out << "phase timings (ns)\n";
+    for (int i = 0; i < PHASE_COUNT; ++i) {
+        out << std::left << std::setw(16) << phaseName(static_cast<Phase>(i))
+            << " p50=" << phases[i].percentile(50.0)
+            << " p99=" << phases[i].percentile(99.0)
+            << " max=" << phases[i].max()
+            << " count=" << phases[i].count() << '\n';
+    }
+}
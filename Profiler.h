@@ -0,0 +1,62 @@
+#pragma once
+#include <chrono>
+#include <ostream>
+#include <string>
+#include "LatencyHistogram.h"
+
+// Per-phase timing of the game cycle.
+// Each phase wrapped in a Profiler::Scope records its duration (nanoseconds) into
+// its own histogram; while the profiler is off a scope costs one branch.
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum Phase {
+        INPUT,            // dispatching the keys collected since the last cycle
+        UPDATE_PLAYERS,
+        UPDATE_TIMERS,    // bomb countdowns/detonations, spring expiry
+        LEVEL_TRANSITION,
+        DRAW_PLAYERS,
+        DRAW_LEGEND,
+        PRESENT,          // frame diff and terminal output
+        CYCLE,            // whole tick() call
+        PHASE_COUNT
+    };
+
+    class Scope {
+        Profiler& profiler;
+        Phase phase;
+        Clock::time_point start;
+        bool active;
+
+    public:
+        Scope(Profiler& owner, Phase timedPhase)
+            : profiler(owner), phase(timedPhase), active(owner.enabled)
+        {
+            if (active) start = Clock::now();
+        }
+        ~Scope() {
+            if (active) profiler.record(phase, Clock::now() - start);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+private:
+    LatencyHistogram phases[PHASE_COUNT];
+    bool enabled = false;
+
+public:
+    void setEnabled(bool on) { enabled = on; }
+    void toggle() { enabled = !enabled; }
+    bool isEnabled() const { return enabled; }
+    bool hasSamples() const;
+
+    void record(Phase phase, Clock::duration elapsed);
+
+    static const char* phaseName(Phase phase);
+
+    // p50/p99/max (and the rest of the summary) per phase
+    void writeReport(std::ostream& out) const;
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include "Constants.h"
+
+// One character cell of the game view
+struct RenderCell {
+    char ch;
+    unsigned char color;
+
+    bool operator==(const RenderCell& other) const { return ch == other.ch && color == other.color; }
+    bool operator!=(const RenderCell& other) const { return !(*this == other); }
+};
+
+// Output backend of the Renderer.
+// present() hands every changed run of cells to the sink, bracketed by beginFrame()/endFrame().
+class RenderSink {
+public:
+    static constexpr int WIDTH = GameConstants::CONSOLE_WIDTH;
+    static constexpr int HEIGHT = GameConstants::statusRow + 1;
+
+    virtual ~RenderSink() = default;
+
+    virtual void beginFrame() {}
+    virtual void writeRun(int x, int y, const RenderCell* cells, int count) = 0;
+    virtual void endFrame() {}
+
+    // Wipe everything the sink shows
+    virtual void clear() = 0;
+
+    // True when a person is watching (blocking prompts and display delays make sense)
+    virtual bool isInteractive() const { return false; }
+};
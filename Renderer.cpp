@@ -0,0 +1,71 @@
+#include "Renderer.h"
+#include "TerminalSink.h"
+#include "console.h"
+
+thread_local Renderer* Renderer::current = nullptr;
+
+namespace {
+    constexpr unsigned char DEFAULT_COLOR = static_cast<unsigned char>(Color::White);
+    constexpr Renderer::Cell BLANK_CELL = { ' ', DEFAULT_COLOR };
+}
+
+Renderer::Renderer(RenderSink& outputSink) : sink(outputSink) {
+    for (int y = 0; y < HEIGHT; ++y) {
+        for (int x = 0; x < WIDTH; ++x) {
+            front[y][x] = BLANK_CELL;
+            back[y][x] = BLANK_CELL;
+        }
+    }
+}
+
+Renderer& Renderer::active() {
+    // used when no Game has bound its renderer on this thread
+    static thread_local TerminalSink fallbackSink;
+    static thread_local Renderer fallback(fallbackSink);
+    return current ? *current : fallback;
+}
+
+void Renderer::putChar(int x, int y, char c, int color) {
+    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return;
+    back[y][x] = { c, static_cast<unsigned char>(color) };
+}
+
+void Renderer::putText(int x, int y, const std::string& text, int color) {
+    for (size_t i = 0; i < text.size(); ++i) {
+        putChar(x + (int)i, y, text[i], color);
+    }
+}
+
+void Renderer::present() {
+    sink.beginFrame();
+
+    for (int y = 0; y < HEIGHT; ++y) {
+        int x = 0;
+        while (x < WIDTH) {
+            if (back[y][x] == front[y][x]) {
+                ++x;
+                continue;
+            }
+
+            // Collect the run of changed cells starting here
+            int runStart = x;
+            while (x < WIDTH && back[y][x] != front[y][x]) {
+                front[y][x] = back[y][x];
+                ++x;
+            }
+            sink.writeRun(runStart, y, &back[y][runStart], x - runStart);
+        }
+    }
+
+    sink.endFrame();
+}
+
+void Renderer::clear() {
+    sink.clear();
+    for (int y = 0; y < HEIGHT; ++y) {
+        for (int x = 0; x < WIDTH; ++x) {
+            front[y][x] = BLANK_CELL;
+            back[y][x] = BLANK_CELL;
+        }
+    }
+}
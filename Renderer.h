@@ -0,0 +1,56 @@
+#pragma once
+#include <string>
+#include "Constants.h"
+#include "RenderSink.h"
+
+// Double-buffered frame renderer.
+// Game code writes cells into the back buffer; present() diffs it against the
+// front buffer (what the sink currently shows) and hands only the changed runs to the sink.
+class Renderer {
+public:
+    static constexpr int WIDTH = RenderSink::WIDTH;
+    static constexpr int HEIGHT = RenderSink::HEIGHT;
+
+    using Cell = RenderCell;
+
+private:
+    Cell front[HEIGHT][WIDTH];
+    Cell back[HEIGHT][WIDTH];
+    RenderSink& sink;
+
+    static thread_local Renderer* current; // bound per thread, so sessions on other threads don't interfere
+
+    Renderer(const Renderer&) = delete;
+    Renderer& operator=(const Renderer&) = delete;
+
+public:
+    explicit Renderer(RenderSink& outputSink);
+
+    // Back buffer access
+    void putChar(int x, int y, char c, int color);
+    void putText(int x, int y, const std::string& text, int color);
+
+    // Diff back against front and send the changes to the sink
+    void present();
+
+    // Clear the sink and both buffers
+    void clear();
+
+    RenderSink& getSink() const { return sink; }
+    bool isInteractive() const { return sink.isInteractive(); }
+
+    // Renderer that Point::draw() and the HUD write into
+    static Renderer& active();
+
+    // Makes a renderer the active one on this thread for the scope's lifetime
+    class Scope {
+        Renderer* previous;
+
+    public:
+        explicit Scope(Renderer& renderer) : previous(current) { current = &renderer; }
+        ~Scope() { current = previous; }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+};
@@ -0,0 +1,79 @@
+#include "Replay.h"
+#include "Game.h"
+#include "GameOptions.h"
+#include "GridSink.h"
+#include "InputLog.h"
+#include "Riddle.h"
+#include "Constants.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+int runReplay(const std::string& filename) {
+    InputLog log;
+    std::string error;
+    if (!log.load(filename, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    const InputLog::Header& header = log.getHeader();
+    const std::vector<InputLog::Entry>& entries = log.getEntries();
+
+    // Riddle prompts take the recorded answers in order
+    std::vector<char> answers;
+    for (const InputLog::Entry& e : entries) {
+        if (e.kind == InputLog::Kind::RIDDLE_ANSWER) answers.push_back(e.key);
+    }
+    size_t nextAnswer = 0;
+
+    GameOptions options;
+    options.tickRate = header.tickRate;
+    options.startMap = header.startMap;
+    options.colors = header.colors;
+    options.keepRevealed = header.keepRevealed;
+    options.sound = false; // no bells at replay speed
+
+    GridSink sink;
+    Game game(&sink, options);
+    game.setRiddleAnswerSource([&answers, &nextAnswer] {
+        return nextAnswer < answers.size() ? answers[nextAnswer++] : GameConstants::KEY_ESC;
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    if (!game.begin()) {
+        return 1;
+    }
+    if (game.getScreenCount() != header.mapCount) {
+        std::fprintf(stderr, "warning: recorded with %d screen files, found %d\n",
+            header.mapCount, game.getScreenCount());
+    }
+
+    size_t next = 0;
+    while (game.isRunning()) {
+        bool finished = (log.getEndTick() >= 0) ? game.getTickCount() >= log.getEndTick()
+                                                : next >= entries.size();
+        if (finished) break;
+
+        for (; next < entries.size() && entries[next].tick <= game.getTickCount(); ++next) {
+            if (entries[next].kind == InputLog::Kind::KEY && game.isRunning()) {
+                game.handleInput(entries[next].key);
+            }
+        }
+        if (!game.isRunning()) break;
+        game.tick();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // FNV-1a over the last frame, to compare runs of the same log
+    unsigned long long hash = 14695981039346656037ull;
+    for (int y = 0; y < RenderSink::HEIGHT; ++y) {
+        for (char c : sink.getRow(y)) {
+            hash = (hash ^ (unsigned char)c) * 1099511628211ull;
+        }
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(elapsed).count();
+    std::printf("replayed %lld ticks (%zu inputs) in %.2f ms\n", game.getTickCount(), entries.size(), ms);
+    std::printf("final frame checksum %016llx\n", hash);
+    return 0;
+}
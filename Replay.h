@@ -0,0 +1,7 @@
+#pragma once
+#include <string>
+
+// Replays an input log recorded with --record (run with: game --replay <file>).
+// Runs headless with no frame pacing and prints the tick count, the elapsed time
+// and a checksum of the final frame. Returns the process exit code.
+int runReplay(const std::string& filename);
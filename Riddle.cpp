@@ -5,6 +5,8 @@
 #include "utils.h"
 #include "console.h"
 #include "Constants.h"
+#include "Renderer.h"
+#include "GameContext.h"
 
 using namespace GameConstants;
 
@@ -16,13 +18,6 @@ using namespace GameConstants;
 #include <cctype>
 
 namespace {
-    struct Riddle {
-        std::string question;
-        std::string answer;
-    };
-
-    std::vector<Riddle> riddles;
-    int nextRiddleIndex = 0;
 
     std::string trim(const std::string& s) {
     size_t start = 0, end = s.size();
@@ -68,71 +63,44 @@ namespace {
         }
 
         // Draw box
-        gotoxy(boxX, boxY);
-        std::cout << "+" << std::string(boxWidth - 2, '-') << "+";
+        Renderer& renderer = Renderer::active();
+        const int color = static_cast<int>(Color::White);
+        renderer.putText(boxX, boxY, "+" + std::string(boxWidth - 2, '-') + "+", color);
         for (int y = 1; y < boxHeight - 1; ++y) {
-            gotoxy(boxX, boxY + y);
-            std::cout << "|" << std::string(boxWidth - 2, ' ') << "|";
+            renderer.putText(boxX, boxY + y, "|" + std::string(boxWidth - 2, ' ') + "|", color);
         }
-        gotoxy(boxX, boxY + boxHeight - 1);
-        std::cout << "+" << std::string(boxWidth - 2, '-') << "+";
+        renderer.putText(boxX, boxY + boxHeight - 1, "+" + std::string(boxWidth - 2, '-') + "+", color);
 
         // Draw riddle text
         for (int i = 0; i < (int)lines.size() && (1 + i) < boxHeight - 2; ++i) {
-            gotoxy(boxX + 2, boxY + 1 + i);
-            std::cout << lines[i];
+            renderer.putText(boxX + 2, boxY + 1 + i, lines[i], color);
         }
 
         int answerY = boxY + 1 + (int)lines.size();
         if (answerY < boxY + boxHeight - 2) {
-            gotoxy(boxX + 2, answerY);
-            std::cout << "Answer: ";
+            renderer.putText(boxX + 2, answerY, "Answer: ", color);
         }
-        std::cout.flush();
-    }
-
-    // Helper: Get user's answer to riddle
-    char getUserRiddleAnswer() {
-        char ans = 0;
-        while (true) {
-            ans = get_single_char();
-            if (ans == '\r' || ans == '\n') continue;
-
-            // Check for ESC before conversion
-            if (ans == KEY_ESC) break;
-
-            // Convert to uppercase 
-            ans = (char)std::toupper((unsigned char)ans);
-
-            // Only accept valid multiple choice options
-            if (ans == 'A' || ans == 'B' || ans == 'C') break;
-            
-        }
-        return ans;
+        renderer.present(); // the game loop is blocked until the player answers
     }
 
     // Helper: Restore screen from backup
     void restoreScreenArea(int boxX, int boxY, int boxWidth, int boxHeight,
                            const std::vector<std::string>& backup, Screen* screen) {
+        Screen::Batch batch(*screen); // every cell of the box is redrawn once
         for (int y = 0; y < boxHeight; ++y) {
             for (int x = 0; x < boxWidth; ++x) {
                 screen->setCharAt(boxX + x, boxY + y, backup[y][x]);
             }
         }
-        for (int y = 0; y < boxHeight; ++y) {
-            for (int x = 0; x < boxWidth; ++x) {
-                screen->drawCharOnly(boxX + x, boxY + y);
-            }
-        }
     }
 } 
 
-bool initRiddles(std::string& errorMessage) {
+bool RiddleBook::load(std::string& errorMessage) {
     riddles.clear();
     nextRiddleIndex = 0;
     errorMessage.clear();
 
-    std::ifstream in("Data/riddles.txt");
+    std::ifstream in(SOURCE_FILE);
     if (!in) {
         errorMessage = "Cannot open riddles.txt - file is missing!";
         return false;
@@ -173,8 +141,27 @@ bool initRiddles(std::string& errorMessage) {
     return true;
 }
 
-int getRiddleCount() {
-    return (int)riddles.size();
+char readRiddleAnswerFromKeyboard() {
+    // Nobody to ask when running headless - treat as canceled
+    if (!Renderer::active().isInteractive()) return KEY_ESC;
+
+    char ans = 0;
+    while (true) {
+        int key = get_single_char();
+        if (key == EOF) return KEY_ESC; // input closed
+        ans = (char)key;
+        if (ans == '\r' || ans == '\n') continue;
+
+        // Check for ESC before conversion
+        if (ans == KEY_ESC) break;
+
+        // Convert to uppercase 
+        ans = (char)std::toupper((unsigned char)ans);
+
+        // Only accept valid multiple choice options
+        if (ans == 'A' || ans == 'B' || ans == 'C') break;
+    }
+    return ans;
 }
 
 bool Player::processRiddle(const Point& next, char nextChar) {
@@ -184,13 +171,15 @@ bool Player::processRiddle(const Point& next, char nextChar) {
 }
 
 void Player::handleRiddle(const Point& riddlePos) {
-    if (nextRiddleIndex >= (int)riddles.size()) return;
+    if (!context) return;
+    RiddleBook& book = context->riddles;
+    if (!book.next()) return;
 
     // Save player direction
     int savedDx = body[0].getDx();
     int savedDy = body[0].getDy();
 
-    const Riddle& r = riddles[nextRiddleIndex];
+    const RiddleBook::Riddle& r = *book.next();
 
     // Prepare riddle display
     std::vector<std::string> lines = prepareRiddleLines(r.question);
@@ -210,7 +199,7 @@ void Player::handleRiddle(const Point& riddlePos) {
     drawRiddleBox(boxX, boxY, boxWidth, boxHeight, lines, backup, screen);
 
     // Get user answer
-    char ans = getUserRiddleAnswer();
+    char ans = book.readAnswer();
 
     // Process answer
     std::string userAnswer;
@@ -221,23 +210,27 @@ void Player::handleRiddle(const Point& riddlePos) {
     bool isCorrect = (!correct.empty() && userNorm == correct);
 
     // Display result
-    gotoxy(boxX + 2, boxY + boxHeight - 2);
+    std::string result;
     if (ans == KEY_ESC) {
-        std::cout << "Canceled.";
+        result = "Canceled.";
     }
     else if (isCorrect) {
-        std::cout << "Correct!";
+        result = "Correct!";
         playSound("correct");
         addScore(SCORE_RIDDLE_CORRECT);
     }
     else {
-        std::cout << "Wrong answer. Correct: " << r.answer;
+        result = "Wrong answer. Correct: " + r.answer;
         playSound("wrong");
         loseScore(SCORE_RIDDLE_PENALTY);
     }
-    std::cout.flush();
-    sleep_ms(RIDDLE_FEEDBACK_DELAY_MS);
-    ++nextRiddleIndex;
+    Renderer::active().putText(boxX + 2, boxY + boxHeight - 2, result, static_cast<int>(Color::White));
+    Renderer::active().present();
+    if (Renderer::active().isInteractive()) sleep_ms(RIDDLE_FEEDBACK_DELAY_MS);
+    book.advance();
+    if (context->observer) {
+        context->observer->onRiddleAnswered(screen->getCurrentMap(), isCorrect, ans == KEY_ESC);
+    }
 
     // Restore screen
     restoreScreenArea(boxX, boxY, boxWidth, boxHeight, backup, screen);
@@ -248,6 +241,7 @@ void Player::handleRiddle(const Point& riddlePos) {
         screen->setCharAt(riddlePos, EMPTY);
         screen->drawCharOnly(riddlePos.getX(), riddlePos.getY());
         body[0].set(riddlePos.getX(), riddlePos.getY());
+        updateOccupancy();
         body[0].draw();
     }
 
@@ -258,7 +252,3 @@ void Player::handleRiddle(const Point& riddlePos) {
     else if (savedDx == 0 && savedDy == 1) body[0].setDirection(Direction::DOWN);
     else if (savedDx == 0 && savedDy == -1) body[0].setDirection(Direction::UP);
 }
-
-void resetRiddlesIndex() {
-    nextRiddleIndex = 0;
-}
\ No newline at end of file
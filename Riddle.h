@@ -1,11 +1,55 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <functional>
 
-// Riddle system initialization and validation
-// Returns true if riddles are loaded successfully, false otherwise
-bool initRiddles(std::string& errorMessage);
-void resetRiddlesIndex();
+// Where riddle answers come from: 'A'-'C', or KEY_ESC to cancel.
+// The keyboard is used when no source is set; recording and replay install their own.
+using RiddleAnswerSource = std::function<char()>;
+char readRiddleAnswerFromKeyboard();
 
-// Get the number of loaded riddles
-int getRiddleCount();
+// The riddles of one game session and how far through them the players are
+class RiddleBook {
+public:
+    static constexpr const char* SOURCE_FILE = "Data/riddles.txt";
+
+    struct Riddle {
+        std::string question;
+        std::string answer;
+    };
+
+private:
+    std::vector<Riddle> riddles;
+    int nextRiddleIndex = 0;
+    RiddleAnswerSource answerSource;
+
+public:
+    // Riddle system initialization and validation
+    // Returns true if riddles are loaded successfully, false otherwise
+    bool load(std::string& errorMessage);
+    void resetIndex() { nextRiddleIndex = 0; }
+
+    // Get the number of loaded riddles
+    int count() const { return (int)riddles.size(); }
+
+    // The riddle to ask next; null once all have been asked
+    const Riddle* next() const {
+        return nextRiddleIndex < (int)riddles.size() ? &riddles[nextRiddleIndex] : nullptr;
+    }
+    void advance() { ++nextRiddleIndex; }
+
+    const std::vector<Riddle>& getAll() const { return riddles; }
+    void add(std::string question, std::string answer) {
+        riddles.push_back({ std::move(question), std::move(answer) });
+    }
+
+    // Take the riddles of a preloaded book (see GameAssets), keeping this book's answer source
+    void assign(const RiddleBook& loaded) {
+        riddles = loaded.riddles;
+        nextRiddleIndex = 0;
+    }
+
+    void setAnswerSource(RiddleAnswerSource source) { answerSource = std::move(source); }
+    char readAnswer() const { return answerSource ? answerSource() : readRiddleAnswerFromKeyboard(); }
+};
@@ -3,18 +3,29 @@
 #include "Screen.h"
 #include "utils.h"
 #include "console.h"
+#include "GameAssets.h"
+#include "LevelPrefetcher.h"
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <algorithm> //  min, max
 #include <stdexcept>
 #include <cstdio>
+#include <cstring>
+#include <cstdlib>
 // console.h provides cross-platform file utilities; no platform-specific includes here
 
 bool Screen::loadScreenFiles() {
+    if (assets) {
+        screenFiles = assets->getScreenFiles();
+        return !screenFiles.empty();
+    }
+
     screenFiles = findScreenFiles();
     // Ensure lexicographic sorting for correct level order (e.g., level_01, level_02, ...)
     std::sort(screenFiles.begin(), screenFiles.end());
+    levelCache.clear();
+    levelCache.resize(screenFiles.size());
     return !screenFiles.empty();
 }
 
@@ -27,88 +38,211 @@ const std::string& Screen::getScreenFilename(int index) const {
 using namespace GameConstants;
 
 Screen::Screen() : currentMapIndex(0), legendPos(0, 0) {
+    resetOccupants();
+    std::memset(launchRuns, 0, sizeof(launchRuns));
+    std::memset(lightCount, 0, sizeof(lightCount));
+    std::memset(lightStamp, 0, sizeof(lightStamp));
+    resetBoard(board);
+    std::memset(entityGrid, 0, sizeof(entityGrid));
+}
+
+void Screen::resetBoard(char* cells) {
+    // border and padding are walls, so one step off the map still reads as WALL
+    std::memset(cells, WALL, BOARD_SIZE);
     for (int y = 0; y < MAX_Y; ++y) {
-        for (int x = 0; x < MAX_X; ++x) {
-            board[y][x] = EMPTY;
-        }
-        board[y][MAX_X] = '\0';
+        std::memset(cells + boardIndex(0, y), EMPTY, MAX_X);
     }
 }
 
+Screen::~Screen() = default;
+
 bool Screen::setMap(int index) {
     if (index < 0 || index >= (int)screenFiles.size()) return false;
     currentMapIndex = index;
-    return loadMap(screenFiles[index]);
-}
-
-bool Screen::loadMap(const std::string& filename) {
-    keys.clear();
-    obstacles.clear();
-    torches.clear();
-    switches.clear();
-    springs.clear();
     lastError.clear();
 
-    std::ifstream file(filename);
+    if (assets) {
+        restoreLevel(assets->getLevel(index));
+        resetLights();
+        resetOccupants();
+        return true;
+    }
+
+    if (!levelCache[index] && prefetcher) {
+        levelCache[index] = prefetcher->take(index);
+    }
+    if (levelCache[index]) {
+        restoreLevel(*levelCache[index]);
+    }
+    else {
+        // First visit and not prefetched: read and parse the file, then keep the result
+        if (!loadMap(screenFiles[index])) return false;
+        auto parsed = std::make_unique<Level>();
+        saveLevel(*parsed);
+        levelCache[index] = std::move(parsed);
+    }
+
+    resetLights();
+    resetOccupants();
+    prefetchReachable();
+    return true;
+}
+
+void Screen::prefetchReachable() {
+    // Every level behind a door of this room, plus the game-over screen
+    bool reachable[MAX_DOORS + 1] = {};
     for (int y = 0; y < MAX_Y; ++y) {
         for (int x = 0; x < MAX_X; ++x) {
-            board[y][x] = EMPTY;
+            char c = cellAt(x, y);
+            if (Tiles::of(c).has(Tiles::DOOR)) {
+                int destination = doorDestination(currentMapIndex, c - DOOR_START);
+                if (destination <= MAX_DOORS) reachable[destination] = true;
+            }
         }
     }
-    if (!file) {
+
+    int lastScreen = (int)screenFiles.size() - 1;
+    for (int index = 0; index <= lastScreen; ++index) {
+        bool wanted = index == lastScreen || (index <= MAX_DOORS && reachable[index]);
+        if (!wanted || levelCache[index]) continue;
+        if (!prefetcher) prefetcher = std::make_unique<LevelPrefetcher>();
+        prefetcher->request(index, screenFiles[index]);
+    }
+}
+
+void Screen::saveLevel(Level& level) const {
+    std::memcpy(level.board, board, sizeof(board));
+    std::memcpy(level.entityGrid, entityGrid, sizeof(entityGrid));
+    level.entities = entities;
+    std::memcpy(level.switchGroupTotal, switchGroupTotal, sizeof(switchGroupTotal));
+    std::memcpy(level.switchGroupOn, switchGroupOn, sizeof(switchGroupOn));
+    level.legendPos = legendPos;
+    level.hasLegend = legendInMap;
+}
+
+void Screen::indexLevel(Level& level) {
+    std::memset(level.entityGrid, 0, sizeof(level.entityGrid));
+    std::memset(level.switchGroupTotal, 0, sizeof(level.switchGroupTotal));
+    std::memset(level.switchGroupOn, 0, sizeof(level.switchGroupOn));
+
+    const EntityTable& table = level.entities;
+    for (size_t i = 0; i < table.size(); ++i) {
+        level.entityGrid[boardIndex(table.cell[i] % MAX_X, table.cell[i] / MAX_X)] = static_cast<std::uint16_t>(i + 1);
+    }
+    for (size_t i = 0; i < table.size(); ++i) {
+        if (table.kind[i] != EntityKind::SWITCH) continue;
+        int group = table.state[i] & EntityTable::SWITCH_GROUP;
+        if (group >= MAX_DOORS) continue;
+        level.switchGroupTotal[group]++;
+        if (table.state[i] & EntityTable::SWITCH_ON) level.switchGroupOn[group]++;
+    }
+}
+
+void Screen::restoreLevel(const Level& level) {
+    // Plain copies; the entity table reuses the capacity of the previous map
+    std::memcpy(board, level.board, sizeof(board));
+    std::memcpy(entityGrid, level.entityGrid, sizeof(entityGrid));
+    entities = level.entities;
+    std::memcpy(switchGroupTotal, level.switchGroupTotal, sizeof(switchGroupTotal));
+    std::memcpy(switchGroupOn, level.switchGroupOn, sizeof(switchGroupOn));
+    if (level.hasLegend) legendPos = level.legendPos;
+    legendInMap = level.hasLegend;
+    rebuildLaunchRuns();
+}
+
+bool Screen::readMapFile(const std::string& filename, std::vector<std::string>& lines) {
+    std::ifstream file(filename);
+    if (!file) return false;
+
+    lines.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        lines.push_back(line);
+    }
+    return true;
+}
+
+bool Screen::loadMap(const std::string& filename) {
+    lastError.clear();
+
+    std::vector<std::string> lines;
+    if (!readMapFile(filename, lines)) {
+        parseMap({});
         lastError = "Cannot open file: " + filename;
         return false;
         // Or: throw std::runtime_error("Cannot open file: " + filename);
     }
-    std::string line;
+
+    parseMap(lines);
+    return true;
+}
+
+void Screen::parseMap(const std::vector<std::string>& lines) {
+    clearEntities();
+    legendInMap = false;
+    resetBoard(board);
+
     int row = 0;
-    while (std::getline(file, line) && row < MAX_Y) {
+    for (; row < (int)lines.size() && row < MAX_Y; ++row) {
+        const std::string& line = lines[row];
         for (int col = 0; col < (int)line.length() && col < MAX_X; ++col) {
             char c = line[col];
-            board[row][col] = c;
-            if (c == KEY) keys.emplace_back(col, row);
-            else if (c == OBSTACLE) obstacles.emplace_back(col, row);
-            else if (c == TORCH) torches.emplace_back(col, row);
-            else if (c == SPRING) springs.emplace_back(col, row);
-            else if (c == SWITCH_OFF || c == SWITCH_ON) {
+            cellAt(col, row) = c;
+            switch (Tiles::of(c).handler) {
+            case Tiles::Handler::KEY:
+                addKey(Point(col, row));
+                break;
+            case Tiles::Handler::OBSTACLE:
+                addEntity(Point(col, row), EntityKind::OBSTACLE);
+                break;
+            case Tiles::Handler::TORCH:
+                addTorch(Point(col, row));
+                break;
+            case Tiles::Handler::SPRING:
+                addEntity(Point(col, row), EntityKind::SPRING);
+                break;
+            case Tiles::Handler::SWITCH: {
                 int group = 0;
                 if (col + 1 < (int)line.length() && line[col + 1] >= '0' && line[col + 1] <= '9') {
                     group = line[col + 1] - '0';
-                    board[row][col + 1] = EMPTY;
+                    if (col + 1 < MAX_X) cellAt(col + 1, row) = EMPTY; // never the border
                     col++;
                 }
-                switches.emplace_back(col - (group > 0 ? 1 : 0), row, group, c == SWITCH_ON);
+                addSwitch(Point(col - (group > 0 ? 1 : 0), row), group, c == SWITCH_ON);
+                break;
             }
-            else if (c == 'L') {
+            case Tiles::Handler::LEGEND:
                 legendPos = Point(col, row);
-                board[row][col] = EMPTY;
+                legendInMap = true;
+                cellAt(col, row) = EMPTY;
+                break;
+            default:
+                break;
             }
         }
-        row++;
     }
     // Continue scanning remaining lines for a legend marker 'L' (some maps put it after the map)
-    while (std::getline(file, line)) {
+    for (; row < (int)lines.size(); ++row) {
+        const std::string& line = lines[row];
         for (int col = 0; col < (int)line.length(); ++col) {
             if (line[col] == 'L') {
                 int yPos = std::min(row, MAX_Y - 1);
                 int xPos = std::min(col, MAX_X - 1);
                 legendPos = Point(xPos, yPos);
+                legendInMap = true;
                 // ensure board shows empty at legend position
-                board[yPos][xPos] = EMPTY;
+                cellAt(xPos, yPos) = EMPTY;
             }
         }
-        row++;
     }
-    file.close();
-    return true;
+    rebuildLaunchRuns();
 }
 
 void Screen::draw() const {
     for (int y = 0; y < MAX_Y; ++y) {
-        gotoxy(0, y);
         for (int x = 0; x < MAX_X; ++x) {
-            char c = board[y][x];
-            if (c == WALL_X) c = EMPTY;
+            char c = cellAt(x, y);
+            if (Tiles::of(c).has(Tiles::HIDDEN) && !showsHiddenWall(x, y)) c = EMPTY;
             Point(x, y, 0, 0, c).draw();
         }
     }
@@ -117,15 +251,16 @@ void Screen::draw() const {
 void Screen::drawCharOnly(int x, int y) const {
     if (x < 0 || x >= MAX_X || y < 0 || y >= MAX_Y) return;
     if (isLegendArea(Point(x, y))) return;
-    char c = board[y][x];
-    if (c == WALL_X) c = EMPTY; 
+    char c = cellAt(x, y);
+    if (Tiles::of(c).has(Tiles::HIDDEN) && !showsHiddenWall(x, y)) c = EMPTY;
 
     Point(x, y, 0, 0, c).draw();
 }
 
 char Screen::getCharAt(int x, int y) const {
-    if (x < 0 || x >= MAX_X || y < 0 || y >= MAX_Y) return WALL;
-    return board[y][x];
+    // the border answers for one step outside the map
+    if (x < -1 || x > MAX_X || y < -1 || y > MAX_Y) return WALL;
+    return cellAt(x, y);
 }
 
 char Screen::getCharAt(const Point& p) const {
@@ -134,123 +269,297 @@ char Screen::getCharAt(const Point& p) const {
 
 void Screen::setCharAt(int x, int y, char c) {
     if (x < 0 || x >= MAX_X || y < 0 || y >= MAX_Y) return;
-    board[y][x] = c;
-    drawCharOnly(x, y);
+    bool wasWall = Tiles::of(cellAt(x, y)).has(Tiles::SOLID);
+    bool wasBlocking = blocksLaunch(x, y);
+    cellAt(x, y) = c;
+    if (wasWall != Tiles::of(c).has(Tiles::SOLID)) wallChanged(x, y); // light may now pass, or stop
+    if (wasBlocking != blocksLaunch(x, y)) updateLaunchRuns(x, y);
+    redrawCell(x, y);
+}
+
+void Screen::rebuildLaunchRuns() {
+    // a cell's run is 0 if its neighbour blocks, else one more than the neighbour's run;
+    // the border blocks, so each line is filled starting from the edge it runs towards
+    std::uint8_t* up = launchRuns[static_cast<int>(Direction::UP)];
+    std::uint8_t* right = launchRuns[static_cast<int>(Direction::RIGHT)];
+    std::uint8_t* down = launchRuns[static_cast<int>(Direction::DOWN)];
+    std::uint8_t* left = launchRuns[static_cast<int>(Direction::LEFT)];
+
+    for (int y = 0; y < MAX_Y; ++y) {
+        left[y * MAX_X] = 0;
+        for (int x = 1; x < MAX_X; ++x) {
+            left[y * MAX_X + x] = blocksLaunch(x - 1, y) ? 0 : left[y * MAX_X + x - 1] + 1;
+        }
+        right[y * MAX_X + MAX_X - 1] = 0;
+        for (int x = MAX_X - 2; x >= 0; --x) {
+            right[y * MAX_X + x] = blocksLaunch(x + 1, y) ? 0 : right[y * MAX_X + x + 1] + 1;
+        }
+    }
+    for (int x = 0; x < MAX_X; ++x) {
+        up[x] = 0;
+        for (int y = 1; y < MAX_Y; ++y) {
+            up[y * MAX_X + x] = blocksLaunch(x, y - 1) ? 0 : up[(y - 1) * MAX_X + x] + 1;
+        }
+        down[(MAX_Y - 1) * MAX_X + x] = 0;
+        for (int y = MAX_Y - 2; y >= 0; --y) {
+            down[y * MAX_X + x] = blocksLaunch(x, y + 1) ? 0 : down[(y + 1) * MAX_X + x] + 1;
+        }
+    }
+}
+
+int Screen::launchRun(const Point& p, Direction dir, int playerIndex) const {
+    if (dir == Direction::STAY) return 0;
+    int x = p.getX(), y = p.getY();
+    int run = launchRuns[static_cast<int>(dir)][y * MAX_X + x];
+
+    // Another player on the line ends the flight just before it (at most MAX_PLAYERS checks)
+    int dx = dir == Direction::RIGHT ? 1 : dir == Direction::LEFT ? -1 : 0;
+    int dy = dir == Direction::DOWN ? 1 : dir == Direction::UP ? -1 : 0;
+    for (int i = 0; i < MAX_PLAYERS; ++i) {
+        if (i == playerIndex || occupantCell[i] < 0) continue;
+        int ox = occupantCell[i] % MAX_X, oy = occupantCell[i] / MAX_X;
+        if ((dx != 0 && oy != y) || (dy != 0 && ox != x)) continue;
+        int ahead = (ox - x) * dx + (oy - y) * dy;
+        if (ahead >= 1 && ahead - 1 < run) run = ahead - 1;
+    }
+    return run;
+}
+
+void Screen::updateLaunchRuns(int x, int y) {
+    // Only runs that reach (x, y) change: walk away from it in each direction,
+    // recomputing until a blocking cell ends the line of cells depending on it
+    std::uint8_t* up = launchRuns[static_cast<int>(Direction::UP)];
+    std::uint8_t* right = launchRuns[static_cast<int>(Direction::RIGHT)];
+    std::uint8_t* down = launchRuns[static_cast<int>(Direction::DOWN)];
+    std::uint8_t* left = launchRuns[static_cast<int>(Direction::LEFT)];
+
+    for (int i = x - 1; i >= 0; --i) {
+        right[y * MAX_X + i] = blocksLaunch(i + 1, y) ? 0 : right[y * MAX_X + i + 1] + 1;
+        if (blocksLaunch(i, y)) break;
+    }
+    for (int i = x + 1; i < MAX_X; ++i) {
+        left[y * MAX_X + i] = blocksLaunch(i - 1, y) ? 0 : left[y * MAX_X + i - 1] + 1;
+        if (blocksLaunch(i, y)) break;
+    }
+    for (int j = y - 1; j >= 0; --j) {
+        down[j * MAX_X + x] = blocksLaunch(x, j + 1) ? 0 : down[(j + 1) * MAX_X + x] + 1;
+        if (blocksLaunch(x, j)) break;
+    }
+    for (int j = y + 1; j < MAX_Y; ++j) {
+        up[j * MAX_X + x] = blocksLaunch(x, j - 1) ? 0 : up[(j - 1) * MAX_X + x] + 1;
+        if (blocksLaunch(x, j)) break;
+    }
 }
 
 void Screen::setCharAt(const Point& p, char c) {
     setCharAt(p.getX(), p.getY(), c);
 }
 
+void Screen::markDirty(int x, int y) {
+    dirtyCells.set(y * MAX_X + x);
+    dirtyMinX = std::min(dirtyMinX, x);
+    dirtyMaxX = std::max(dirtyMaxX, x);
+    dirtyMinY = std::min(dirtyMinY, y);
+    dirtyMaxY = std::max(dirtyMaxY, y);
+}
+
+void Screen::flushDirty() {
+    // only scan the bounding box of what changed
+    for (int y = dirtyMinY; y <= dirtyMaxY; ++y) {
+        for (int x = dirtyMinX; x <= dirtyMaxX; ++x) {
+            if (dirtyCells.test(y * MAX_X + x)) drawCharOnly(x, y);
+        }
+    }
+    dirtyCells.reset();
+    dirtyMinX = MAX_X; dirtyMaxX = -1;
+    dirtyMinY = MAX_Y; dirtyMaxY = -1;
+}
+
+void Screen::endBatch() {
+    if (batchDepth <= 0) return;
+    if (--batchDepth == 0) flushDirty();
+}
+
 bool Screen::isWall(const Point& p) const {
     char c = getCharAt(p);
-    return c == WALL || c == WALL_X;
+    return Tiles::of(c).has(Tiles::SOLID);
 }
 
-Key* Screen::getKeyAt(const Point& p) {
-    for (auto& key : keys) {
-        if (key.getPosition().getX() == p.getX() && key.getPosition().getY() == p.getY())
-            return &key;
-    }
-    return nullptr;
+std::uint16_t Screen::handleAt(const Point& p) const {
+    if (p.getX() < 0 || p.getX() >= MAX_X || p.getY() < 0 || p.getY() >= MAX_Y) return 0;
+    return entityGrid[boardIndex(p.getX(), p.getY())];
+}
+
+void Screen::setHandle(const Point& p, std::uint16_t handle) {
+    if (p.getX() < 0 || p.getX() >= MAX_X || p.getY() < 0 || p.getY() >= MAX_Y) return;
+    entityGrid[boardIndex(p.getX(), p.getY())] = handle;
 }
 
-Obstacle* Screen::getObstacleAt(const Point& p) {
-    for (auto& obs : obstacles) {
-        if (obs.getPosition().getX() == p.getX() && obs.getPosition().getY() == p.getY())
-            return &obs;
+void Screen::clearEntities() {
+    entities.clear();
+    for (int g = 0; g < MAX_DOORS; ++g) {
+        switchGroupTotal[g] = 0;
+        switchGroupOn[g] = 0;
     }
-    return nullptr;
+    std::memset(entityGrid, 0, sizeof(entityGrid));
 }
 
-Torch* Screen::getTorchAt(const Point& p) {
-    for (auto& t : torches) {
-        if (t.getPosition().getX() == p.getX() && t.getPosition().getY() == p.getY())
-            return &t;
+void Screen::addEntity(const Point& p, EntityKind kind, std::uint8_t state) {
+    if (p.getX() < 0 || p.getX() >= MAX_X || p.getY() < 0 || p.getY() >= MAX_Y) return;
+    entities.add(static_cast<std::uint16_t>(p.getY() * MAX_X + p.getX()), kind, state);
+    setHandle(p, static_cast<std::uint16_t>(entities.size()));
+}
+
+std::uint16_t Screen::handleOf(const Point& p, EntityKind kind) const {
+    std::uint16_t handle = handleAt(p);
+    return handle && entities.kind[handle - 1] == kind ? handle : 0;
+}
+
+void Screen::removeEntity(const Point& p, EntityKind kind) {
+    std::uint16_t handle = handleOf(p, kind);
+    if (!handle) return;
+
+    // the last row moves into the freed one, then its cell is re-pointed
+    size_t index = handle - 1;
+    setHandle(p, 0);
+    entities.removeSwap(index);
+    if (index < entities.size()) {
+        std::uint16_t moved = entities.cell[index];
+        entityGrid[boardIndex(moved % MAX_X, moved / MAX_X)] = handle;
     }
-    return nullptr;
 }
 
-void Screen::addKey(const Point& p) { keys.emplace_back(p.getX(), p.getY()); }
-void Screen::addTorch(const Point& p) { torches.emplace_back(p.getX(), p.getY()); }
+void Screen::addKey(const Point& p) {
+    addEntity(p, EntityKind::KEY);
+}
+
+void Screen::addTorch(const Point& p) {
+    addEntity(p, EntityKind::TORCH);
+}
 
 void Screen::removeTorch(const Point& p) {
-    for (auto it = torches.begin(); it != torches.end(); ++it) {
-        if (it->getPosition().getX() == p.getX() && it->getPosition().getY() == p.getY()) {
-            torches.erase(it);
-            break;
-        }
-    }
+    removeEntity(p, EntityKind::TORCH);
 }
 
 void Screen::removeKey(const Point& p) {
-    for (auto it = keys.begin(); it != keys.end(); ++it) {
-        if (it->getPosition().getX() == p.getX() && it->getPosition().getY() == p.getY()) {
-            keys.erase(it);
-            break;
-        }
-    }
+    removeEntity(p, EntityKind::KEY);
 }
 
-Switch* Screen::getSwitchAt(const Point& p) {
-    for (auto& sw : switches) {
-        if (sw.getPosition().getX() == p.getX() && sw.getPosition().getY() == p.getY())
-            return &sw;
+void Screen::destroyEntityAt(const Point& p) {
+    std::uint16_t handle = handleAt(p);
+    if (!handle) return;
+
+    EntityKind kind = entities.kind[handle - 1];
+    if (kind == EntityKind::TORCH) {
+        removeLight(p);
+    }
+    else if (kind == EntityKind::SWITCH) {
+        // the remaining switches of the group decide its doors (no "all on" sound for a blast)
+        std::uint8_t state = entities.state[handle - 1];
+        int group = state & EntityTable::SWITCH_GROUP;
+        if (group < MAX_DOORS) {
+            switchGroupTotal[group]--;
+            if (state & EntityTable::SWITCH_ON) switchGroupOn[group]--;
+        }
     }
-    return nullptr;
+    removeEntity(p, kind);
 }
 
-Spring* Screen::getSpringAt(const Point& p) {
-    for (auto& spring : springs) {
-        if (spring.getPosition().getX() == p.getX() && spring.getPosition().getY() == p.getY())
-            return &spring;
+void Screen::addSwitch(const Point& p, int group, bool isOn) {
+    std::uint8_t state = static_cast<std::uint8_t>((group & EntityTable::SWITCH_GROUP) | (isOn ? EntityTable::SWITCH_ON : 0));
+    addEntity(p, EntityKind::SWITCH, state);
+    if (group >= 0 && group < MAX_DOORS) {
+        switchGroupTotal[group]++;
+        if (isOn) switchGroupOn[group]++;
     }
-    return nullptr;
 }
 
-GameObject* Screen::getObjectAt(const Point& p) {
-    // Check each object type and return the first match
+void Screen::moveObstacle(const Point& from, const Point& to) {
+    std::uint16_t handle = handleOf(from, EntityKind::OBSTACLE);
+    if (!handle) return;
+    if (to.getX() < 0 || to.getX() >= MAX_X || to.getY() < 0 || to.getY() >= MAX_Y) return;
+    setHandle(from, 0);
+    setHandle(to, handle);
+    entities.cell[handle - 1] = static_cast<std::uint16_t>(to.getY() * MAX_X + to.getX());
+}
 
-    GameObject* obj = nullptr;
+Entity Screen::entityOf(std::uint16_t handle) const {
+    size_t index = handle - 1;
+    int x = entities.cell[index] % MAX_X;
+    int y = entities.cell[index] / MAX_X;
+
+    switch (entities.kind[index]) {
+    case EntityKind::KEY:      return Key(x, y);
+    case EntityKind::OBSTACLE: return Obstacle(x, y);
+    case EntityKind::TORCH:    return Torch(x, y);
+    case EntityKind::SPRING:   return Spring(x, y);
+    case EntityKind::SWITCH: {
+        std::uint8_t state = entities.state[index];
+        return Switch(x, y, state & EntityTable::SWITCH_GROUP, (state & EntityTable::SWITCH_ON) != 0);
+    }
+    }
+    return Key(x, y); // unreachable: every kind is listed above
+}
 
-    // Springs 
-    obj = getSpringAt(p);
-    if (obj) return obj;
+bool Screen::collide(std::uint16_t handle, Player& player) {
+    // The row becomes its entity class just for this call
+    Entity entity = entityOf(handle);
+    return std::visit([&](auto& object) { return object.handleCollision(player, *this); }, entity);
+}
 
-    // Obstacles 
-    obj = getObstacleAt(p);
-    if (obj) return obj;
+CellProbe Screen::probe(const Point& p) const {
+    // the border cells hold a WALL and no entity or player, so no range check is needed
+    int y = p.getY();
+    int at = boardIndex(p.getX(), y);
+    CellProbe cell;
+    cell.glyph = board[at];
+    cell.tile = Tiles::of(cell.glyph).flags;
+    if (y == legendPos.getY()) cell.tile |= CellProbe::LEGEND;
+    cell.entity = entityGrid[at];
+    cell.players = occupants[at];
+    return cell;
+}
 
-    // Collectible items
-    obj = getKeyAt(p);
-    if (obj) return obj;
+void Screen::resetOccupants() {
+    std::memset(occupants, 0, sizeof(occupants));
+    for (int& cell : occupantCell) cell = -1;
+}
 
-    obj = getTorchAt(p);
-    if (obj) return obj;
+void Screen::setOccupant(int playerIndex, const Point& p, bool active) {
+    std::uint8_t bit = occupantBit(playerIndex);
+    if (!bit) return;
 
-    // Interactive floor tiles
-    obj = getSwitchAt(p);
-    if (obj) return obj;
+    int cell = occupantCell[playerIndex];
+    if (cell >= 0) occupants[boardIndex(cell % MAX_X, cell / MAX_X)] &= (std::uint8_t)~bit;
+    occupantCell[playerIndex] = -1;
 
-    // Doors are handled separately
-    return nullptr;
+    int x = p.getX(), y = p.getY();
+    if (!active || x < 0 || x >= MAX_X || y < 0 || y >= MAX_Y) return;
+    occupantCell[playerIndex] = y * MAX_X + x;
+    occupants[boardIndex(x, y)] |= bit;
 }
 
 void Screen::toggleSwitch(const Point& p) {
-    Switch* sw = getSwitchAt(p);
-    if (sw) {
-        sw->toggle();
-        char c = sw->getState() ? SWITCH_ON : SWITCH_OFF;
-        setCharAt(p, c);
+    std::uint16_t handle = handleOf(p, EntityKind::SWITCH);
+    if (handle) {
+        std::uint8_t& state = entities.state[handle - 1];
+        state ^= EntityTable::SWITCH_ON;
+        bool isOn = (state & EntityTable::SWITCH_ON) != 0;
+        setCharAt(p, isOn ? SWITCH_ON : SWITCH_OFF);
+
+        int group = state & EntityTable::SWITCH_GROUP;
+        if (group >= MAX_DOORS) return;
+        switchGroupOn[group] += isOn ? 1 : -1;
+        if (isOn && switchGroupOn[group] == switchGroupTotal[group] && onSwitchGroupComplete) {
+            onSwitchGroupComplete(group);
+        }
     }
 }
 
 bool Screen::areAllSwitchesOn(int groupId) const {
-    for (const auto& sw : switches) {
-        if (sw.getGroup() == groupId && !sw.getState())
-            return false;
-    }
-    return true;
+    // groups are kept up to date by toggleSwitch(), so this is a single comparison
+    if (groupId < 0 || groupId >= MAX_DOORS) return true;
+    return switchGroupOn[groupId] == switchGroupTotal[groupId];
 }
 
 int Screen::getDoorSwitchGroup(int doorNumber) const {
@@ -258,53 +567,123 @@ int Screen::getDoorSwitchGroup(int doorNumber) const {
 }
 
 
-void Screen::refreshArea(int centerX, int centerY, int radius, bool lookAt) const {// redraw area around (centerX, centerY) with given radius
-    for (int y = centerY - radius; y <= centerY + radius; ++y) {
-        for (int x = centerX - radius; x <= centerX + radius; ++x) {
-            if (x < 0 || x >= MAX_X || y < 0 || y >= MAX_Y ) continue;
-			if (y == legendPos.getY() || y == statusRow) continue; // skip legend area and bottom info area
-            int dx = x - centerX;
-            int dy = y - centerY;
-            if (dx * dx + dy * dy <= radius * radius) {
-                if (lookAt) {
-                    Point(x, y, 0, 0, board[y][x]).draw();
-                }
-                else {
-                    drawCharOnly(x, y);
-                }
+void Screen::resetLights() {
+    ++lightGeneration;
+    std::memset(lightCount, 0, sizeof(lightCount));
+    revealed.reset();
+    lightSources.clear();
+    lightFields.clear(); // the walls are different on every map
+    for (size_t i = 0; i < entities.size(); ++i) {
+        if (entities.kind[i] != EntityKind::TORCH) continue;
+        Point center(entities.cell[i] % MAX_X, entities.cell[i] / MAX_X);
+        LightSource source{ center, lightFieldAt(center) };
+        changeLight(nullptr, source.field.get(), false); // the whole map is drawn after entry
+        lightSources.push_back(std::move(source));
+    }
+}
+
+std::shared_ptr<const LightField> Screen::lightFieldAt(const Point& center) {
+    std::uint32_t key = ((std::uint32_t)(center.getY() * MAX_X + center.getX()) << 8) | (std::uint32_t)Torch::RADIUS;
+    auto found = lightFields.find(key);
+    if (found != lightFields.end()) return found->second;
+
+    auto field = std::make_shared<LightField>();
+    field->centerX = center.getX();
+    field->centerY = center.getY();
+    field->radius = Torch::RADIUS;
+    FieldOfView::compute(*field, MAX_X, MAX_Y, [this](int x, int y) {
+        return Tiles::of(cellAt(x, y)).has(Tiles::SOLID);
+    });
+    lightFields.emplace(key, field);
+    return field;
+}
+
+void Screen::changeLight(const LightField* from, const LightField* to, bool redraw) {
+    if (lightEpoch >= UINT32_MAX - 2) { // stamps are about to wrap
+        std::memset(lightStamp, 0, sizeof(lightStamp));
+        lightEpoch = 0;
+    }
+    const std::uint32_t onlyFrom = ++lightEpoch;
+    const std::uint32_t inBoth = ++lightEpoch;
+
+    // Cells lit by both fields keep their count; only entering and leaving cells change
+    if (from) {
+        for (std::uint16_t cell : from->cells) lightStamp[cell] = onlyFrom;
+    }
+    if (to) {
+        for (std::uint16_t cell : to->cells) {
+            if (lightStamp[cell] == onlyFrom) lightStamp[cell] = inBoth;
+            else if (lightCount[cell]++ == 0) revealCell(cell, redraw);
+        }
+    }
+    if (from) {
+        for (std::uint16_t cell : from->cells) {
+            if (lightStamp[cell] != onlyFrom || lightCount[cell] == 0) continue;
+            // light only changes how hidden walls look, and kept ones stay visible
+            if (--lightCount[cell] == 0 && redraw && !keepRevealed && isHiddenWall(cell)) {
+                redrawCell(cell % MAX_X, cell / MAX_X);
             }
         }
     }
 }
 
-void Screen::updateTorchLocation(const Point& oldP, const Point& newP, int radius) const {
-    int minX = std::min(oldP.getX(), newP.getX()) - radius;
-    int maxX = std::max(oldP.getX(), newP.getX()) + radius;
-    int minY = std::min(oldP.getY(), newP.getY()) - radius;
-    int maxY = std::max(oldP.getY(), newP.getY()) + radius;
+void Screen::revealCell(std::uint16_t cell, bool redraw) {
+    bool wasShown = keepRevealed && revealed.test(cell);
+    revealed.set(cell);
+    if (redraw && !wasShown && isHiddenWall(cell)) redrawCell(cell % MAX_X, cell / MAX_X);
+}
 
-    for (int y = minY; y <= maxY; ++y) {
-        for (int x = minX; x <= maxX; ++x) {
-            if (x < 0 || x >= MAX_X || y < 0 || y >= MAX_Y) continue;
-            if (y == legendPos.getY()) continue;
-            int dxNew = x - newP.getX();
-            int dyNew = y - newP.getY();
-            bool inNew = (dxNew * dxNew + dyNew * dyNew <= radius * radius);
+void Screen::addLight(const Point& center) {
+    LightSource source{ center, lightFieldAt(center) };
+    changeLight(nullptr, source.field.get(), true);
+    lightSources.push_back(std::move(source));
+}
 
-            int dxOld = x - oldP.getX();
-            int dyOld = y - oldP.getY();
-            bool inOld = (dxOld * dxOld + dyOld * dyOld <= radius * radius);
+void Screen::removeLight(const Point& center) {
+    for (size_t i = 0; i < lightSources.size(); ++i) {
+        if (lightSources[i].center.getX() != center.getX() || lightSources[i].center.getY() != center.getY()) continue;
+        changeLight(lightSources[i].field.get(), nullptr, true);
+        lightSources[i] = std::move(lightSources.back());
+        lightSources.pop_back();
+        return;
+    }
+}
 
-            if (inNew) {
-                Point(x, y, 0, 0, board[y][x]).draw();
-            }
-            else if (inOld) {
-                drawCharOnly(x, y);
-            }
-        }
+void Screen::moveLight(const Point& from, const Point& to) {
+    for (LightSource& source : lightSources) {
+        if (source.center.getX() != from.getX() || source.center.getY() != from.getY()) continue;
+        std::shared_ptr<const LightField> field = lightFieldAt(to);
+        changeLight(source.field.get(), field.get(), true);
+        source.center = to;
+        source.field = std::move(field);
+        return;
+    }
+    addLight(to);
+}
+
+void Screen::wallChanged(int x, int y) {
+    auto reaches = [x, y](const LightField& field) {
+        return std::abs(field.centerX - x) <= field.radius && std::abs(field.centerY - y) <= field.radius;
+    };
+
+    for (auto it = lightFields.begin(); it != lightFields.end();) {
+        if (reaches(*it->second)) it = lightFields.erase(it);
+        else ++it;
+    }
+    // Sources keep the field they were lit with until it is replaced here
+    for (LightSource& source : lightSources) {
+        if (!reaches(*source.field)) continue;
+        std::shared_ptr<const LightField> field = lightFieldAt(source.center);
+        changeLight(source.field.get(), field.get(), true);
+        source.field = std::move(field);
     }
 }
 
+void Screen::redrawCell(int x, int y) {
+    if (batchDepth > 0) markDirty(x, y);
+    else drawCharOnly(x, y);
+}
+
     bool Screen::isLegendArea(const Point& p) const {
         // Legend occupies one full-width line at legendPos.y
         if (legendPos.getY() < 0 || legendPos.getY() >= MAX_Y) return false;
@@ -1,6 +1,11 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
 #include "Constants.h"
 #include "Point.h"
 #include "GameObject.h"
@@ -9,34 +14,152 @@
 #include "Torch.h"
 #include "Switch.h"
 #include "Spring.h"
+#include "Entity.h"
+#include "FieldOfView.h"
+#include "CellProbe.h"
 
 
+class GameAssets;
+class LevelPrefetcher;
+class Player;
+
 class Screen {
 public:
     static constexpr int MAX_X = 80;
     static constexpr int MAX_Y = 22;
     static constexpr int WINDOW_HEIGHT = 25;
+    static constexpr int MAX_PLAYERS = 8; // players a board tracks by cell
+
+    // Board storage: the map plus a one-cell WALL border on every side, rows padded
+    // to BOARD_STRIDE. Cell (x, y) is at boardIndex(x, y) for x in [-1, MAX_X], y in [-1, MAX_Y].
+    static constexpr int BOARD_STRIDE = 128;
+    static constexpr int BOARD_SIZE = (MAX_Y + 2) * BOARD_STRIDE;
+    static constexpr int boardIndex(int x, int y) { return (y + 1) * BOARD_STRIDE + (x + 1); }
+
+    // A parsed map (board, entity index and table, legend position). Levels are kept
+    // read-only once parsed; entering a map copies one into the working state.
+    struct Level {
+        Level() { resetBoard(board); }
+
+        char board[BOARD_SIZE];
+        std::uint16_t entityGrid[BOARD_SIZE];
+        EntityTable entities;
+        int switchGroupTotal[GameConstants::MAX_DOORS];
+        int switchGroupOn[GameConstants::MAX_DOORS];
+        Point legendPos;
+        bool hasLegend = false; // maps without an 'L' keep the previous legend position
+    };
 
 private:
-    char board[MAX_Y][MAX_X + 1];
+    alignas(64) char board[BOARD_SIZE];
+    char& cellAt(int x, int y) { return board[boardIndex(x, y)]; }
+    char cellAt(int x, int y) const { return board[boardIndex(x, y)]; }
+    static void resetBoard(char* cells);
     int currentMapIndex;
     std::string lastError;
 
     std::vector<std::string> screenFiles;
-    std::vector<Key> keys;
-    std::vector<Obstacle> obstacles;
-    std::vector<Torch> torches;
-    std::vector<Switch> switches;
-    std::vector<Spring> springs;
+    const GameAssets* assets = nullptr; // preloaded screens; maps are read from disk when null
+    std::vector<std::unique_ptr<const Level>> levelCache; // by map index, filled on first visit without assets
+    std::unique_ptr<LevelPrefetcher> prefetcher; // parses the levels reachable from the current one
+    EntityTable entities; // every entity of the map, cells packed as y * MAX_X + x
+
+    // Per-cell entity index: handle of the entity on each cell (its row + 1), 0 = none.
+    // Laid out like the board (boardIndex), with the border and padding always 0.
+    std::uint16_t entityGrid[BOARD_SIZE];
+
+    std::uint16_t handleAt(const Point& p) const;
+    void setHandle(const Point& p, std::uint16_t handle);
+    void clearEntities();
+
+    void addEntity(const Point& p, EntityKind kind, std::uint8_t state = 0);
+    void removeEntity(const Point& p, EntityKind kind);
+    std::uint16_t handleOf(const Point& p, EntityKind kind) const; // 0 unless that kind is there
+    Entity entityOf(std::uint16_t handle) const; // the row as its entity class
+
     Screen(const Screen&) = delete;
     Screen& operator=(const Screen&) = delete;
 
     Point legendPos;
+    bool legendInMap = false; // the last parsed map had an 'L'
+
+    void restoreLevel(const Level& level);
+    void prefetchReachable();
+
+    // Deferred redraw state (see Screen::Batch)
+    std::bitset<MAX_X * MAX_Y> dirtyCells;
+    int batchDepth = 0;
+    int dirtyMinX = MAX_X, dirtyMaxX = -1;
+    int dirtyMinY = MAX_Y, dirtyMaxY = -1;
+
+    // Switch groups: how many switches each group has and how many are ON
+    int switchGroupTotal[GameConstants::MAX_DOORS] = {};
+    int switchGroupOn[GameConstants::MAX_DOORS] = {};
+    std::function<void(int)> onSwitchGroupComplete;
+
+    void addSwitch(const Point& p, int group, bool isOn);
+
+    // Torch light: how many torches light each cell (index y * MAX_X + x); lit cells
+    // show hidden walls. A source lights the cells it can see; the fields are cached
+    // per (cell, radius) and dropped when a wall within their radius changes.
+    struct LightSource {
+        Point center;
+        std::shared_ptr<const LightField> field;
+    };
+    std::uint16_t lightCount[MAX_Y * MAX_X];
+    std::vector<LightSource> lightSources;
+    std::unordered_map<std::uint32_t, std::shared_ptr<const LightField>> lightFields;
+    std::uint32_t lightStamp[MAX_Y * MAX_X]; // scratch marks for changeLight()
+    std::uint32_t lightEpoch = 0;
+    int lightGeneration = 0; // bumped whenever the light map is rebuilt for a new map
+
+    // Every cell lit since the map was entered; with keepRevealed hidden walls stay shown
+    std::bitset<MAX_X * MAX_Y> revealed;
+    bool keepRevealed = false;
+    void revealCell(std::uint16_t cell, bool redraw);
+    bool isHiddenWall(std::uint16_t cell) const { return Tiles::of(cellAt(cell % MAX_X, cell / MAX_X)).has(Tiles::HIDDEN); }
+
+    void resetLights();
+
+    // Active players by cell (occupantBit per player index, at boardIndex), kept up to date by Player
+    std::uint8_t occupants[BOARD_SIZE];
+    int occupantCell[MAX_PLAYERS]; // packed y * MAX_X + x, -1 = not on the board
+    void resetOccupants();
+    std::shared_ptr<const LightField> lightFieldAt(const Point& center);
+    void changeLight(const LightField* from, const LightField* to, bool redraw);
+    void wallChanged(int x, int y);
+    void redrawCell(int x, int y);
+
+    void markDirty(int x, int y);
+    void flushDirty();
+
+    // Spring flights: for each direction (indexed by Direction) and cell, how many cells
+    // in a row a launched player can fly over before the board stops it. Rebuilt on map entry,
+    // then patched along the cell's row and column whenever a cell starts or stops blocking.
+    // Players are not board cells; launchRun() cuts the run at the nearest one instead.
+    static constexpr std::uint8_t BLOCKS_LAUNCH = Tiles::SOLID | Tiles::DOOR | Tiles::PUSHABLE;
+    std::uint8_t launchRuns[4][MAX_Y * MAX_X];
+    bool blocksLaunch(int x, int y) const { return (Tiles::of(cellAt(x, y)).flags & BLOCKS_LAUNCH) != 0; }
+    void rebuildLaunchRuns();
+    void updateLaunchRuns(int x, int y);
 
 public:
+    // Groups board mutations: inside a batch setCharAt() only marks cells dirty,
+    // and every dirty cell is redrawn once when the outermost batch ends.
+    class Batch {
+        Screen& screen;
+    public:
+        explicit Batch(Screen& s) : screen(s) { screen.beginBatch(); }
+        ~Batch() { screen.endBatch(); }
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+    };
+
     Screen();
+    ~Screen();
 
     // Screen file management
+    void useAssets(const GameAssets* sharedAssets) { assets = sharedAssets; }
     bool loadScreenFiles();
     int getNumScreens() const { return static_cast<int>(screenFiles.size()); }
     const std::string& getScreenFilename(int index) const;
@@ -44,17 +167,36 @@ public:
 
     // Map loading and management
     bool loadMap(const std::string& filename);
-    bool setMap(int index);
+    static bool readMapFile(const std::string& filename, std::vector<std::string>& lines);
+    void parseMap(const std::vector<std::string>& lines); // build board and objects from map text
+    bool setMap(int index); // parses a map on its first visit only
+    void saveLevel(Level& level) const; // snapshot of the freshly parsed map
+    static void indexLevel(Level& level); // entity index and switch counts from the entity lists
     int getCurrentMap() const { return currentMapIndex; }
     std::string getLastError() const { return lastError; }
     void updateScreenIndex() { setMap(currentMapIndex + 1); }
 
+    // Map reached through a door: door '1' (index 0) leads from the lobby to map 1 and
+    // from anywhere else back to the lobby, door 'N' (index N-1) leads to map N
+    static int doorDestination(int currentMap, int doorIndex) {
+        if (doorIndex == 0) return currentMap == 0 ? 1 : 0;
+        return doorIndex + 1;
+    }
+
     // Board access
     char getCharAt(int x, int y) const;
     char getCharAt(const Point& p) const;
+    // No bounds check: only for cells at most one step outside the map (e.g. a
+    // neighbour of an on-map position), where the border reads as WALL
+    char charAtUnchecked(int x, int y) const { return cellAt(x, y); }
+    char charAtUnchecked(const Point& p) const { return cellAt(p.getX(), p.getY()); }
     void setCharAt(int x, int y, char c);
     void setCharAt(const Point& p, char c);
 
+    // Batched mutations (prefer the Batch scope guard)
+    void beginBatch() { ++batchDepth; }
+    void endBatch();
+
     // Drawing
     void draw() const;
     void drawCharOnly(int x, int y) const;
@@ -63,29 +205,52 @@ public:
     bool isWall(const Point& p) const;
     bool isLegendArea(const Point& p) const;
 
-    // Object access - POLYMORPHIC METHOD (returns any GameObject type)
-    GameObject* getObjectAt(const Point& p);
+    // Everything about one cell in one read; p may be one step outside the map
+    CellProbe probe(const Point& p) const;
+    // Free cells the player playerIndex can fly over from p (on the map) towards dir,
+    // stopping short of walls, doors, obstacles and other players; 0 for STAY
+    int launchRun(const Point& p, Direction dir, int playerIndex) const;
+    void setOccupant(int playerIndex, const Point& p, bool active);
+    // Bit of a player in CellProbe::players; 0 for an index outside [0, MAX_PLAYERS)
+    static std::uint8_t occupantBit(int playerIndex) {
+        return playerIndex >= 0 && playerIndex < MAX_PLAYERS ? static_cast<std::uint8_t>(1u << playerIndex) : 0;
+    }
 
-    // Legacy object access (for specific types when needed)
-    Key* getKeyAt(const Point& p);
-    Obstacle* getObstacleAt(const Point& p);
-    Torch* getTorchAt(const Point& p);
-    Switch* getSwitchAt(const Point& p);
-    Spring* getSpringAt(const Point& p);
+    // Object access
+    bool hasEntityAt(const Point& p) const { return handleAt(p) != 0; }
+    bool hasObstacleAt(const Point& p) const { return handleOf(p, EntityKind::OBSTACLE) != 0; }
+    // Runs the collision of the entity with this handle (CellProbe::entity) against the player
+    bool collide(std::uint16_t handle, Player& player);
+    const EntityTable& getEntities() const { return entities; }
 
     // Object management
     void addKey(const Point& p);
     void addTorch(const Point& p);
     void removeTorch(const Point& p);
     void removeKey(const Point& p);
+    void destroyEntityAt(const Point& p); // whatever entity a blast hits: a torch stops lighting, a switch leaves its group
     void toggleSwitch(const Point& p);
+    void moveObstacle(const Point& from, const Point& to); // keep the entity index in sync with a push
+
+    // Called with the group id whenever every switch of a group becomes ON
+    void setSwitchGroupListener(std::function<void(int)> listener) { onSwitchGroupComplete = std::move(listener); }
 
     // Query methods
     bool areAllSwitchesOn(int groupId) const;
     int getDoorSwitchGroup(int doorNumber) const;
     Point getLegendPosition() const { return legendPos; }
 
-    // Visual effects (torch/vision)
-    void refreshArea(int centerX, int centerY, int radius, bool lookAt = true) const;
-    void updateTorchLocation(const Point& oldP, const Point& newP, int radius) const;
+    // Torch light (radius Torch::RADIUS, stopped by walls). Only cells whose lit state
+    // changes are redrawn. The light map is rebuilt from the map's torches on entry.
+    void addLight(const Point& center);
+    void removeLight(const Point& center);
+    void moveLight(const Point& from, const Point& to);
+    bool isLit(int x, int y) const { return lightCount[y * MAX_X + x] != 0; }
+    int getLightGeneration() const { return lightGeneration; }
+
+    // Revealed cells (index y * MAX_X + x), cleared on map entry
+    const std::bitset<MAX_X * MAX_Y>& getRevealed() const { return revealed; }
+    bool isRevealed(int x, int y) const { return revealed.test(y * MAX_X + x); }
+    void setKeepRevealed(bool keep) { keepRevealed = keep; }
+    bool showsHiddenWall(int x, int y) const { return isLit(x, y) || (keepRevealed && isRevealed(x, y)); }
 };
\ No newline at end of file
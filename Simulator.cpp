@@ -0,0 +1,234 @@
+#include "Simulator.h"
+#include "Game.h"
+#include "GameAssets.h"
+#include "GameObserver.h"
+#include "InputLog.h"
+#include "LatencyHistogram.h"
+#include "NullSink.h"
+#include "WorkStealingPool.h"
+#include "Constants.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+    struct SimulationOptions {
+        int sessions = 1000;
+        unsigned threads = 0;
+        int maxTicks = 6000;
+        unsigned seed = 1;
+        std::string policy = "random";
+    };
+
+    struct MapStats {
+        long long visits = 0;
+        long long completions = 0;
+        long long bombHits = 0;
+        long long riddlesAsked = 0;
+        long long riddlePenalties = 0;
+        std::vector<long long> ticksToDoor;
+    };
+
+    // ENDED covers both running out of lives and a scripted quit
+    enum class Outcome { FINISHED, ENDED, TIMED_OUT, FAILED };
+
+    struct SessionResult {
+        Outcome outcome = Outcome::FAILED;
+        long long ticks = 0;
+        std::vector<MapStats> maps;
+    };
+
+    // Turns a session's observer callbacks into per-map counts
+    class SessionRecorder : public GameObserver {
+        SessionResult& result;
+        int finalMap;
+        long long levelStartTick = 0;
+
+    public:
+        SessionRecorder(SessionResult& sessionResult, int mapCount)
+            : result(sessionResult), finalMap(mapCount - 1)
+        {
+            result.maps.resize(mapCount);
+        }
+
+        void onLevelStart(int map, long long tick) override {
+            ++result.maps[map].visits;
+            levelStartTick = tick;
+        }
+        void onLevelComplete(int map, int nextMap, long long tick) override {
+            ++result.maps[map].completions;
+            result.maps[map].ticksToDoor.push_back(tick - levelStartTick);
+            if (nextMap == finalMap) result.outcome = Outcome::FINISHED;
+        }
+        void onBombHit(int map, int) override {
+            ++result.maps[map].bombHits;
+        }
+        void onRiddleAnswered(int map, bool correct, bool canceled) override {
+            ++result.maps[map].riddlesAsked;
+            if (!correct && !canceled) ++result.maps[map].riddlePenalties;
+        }
+    };
+
+    // Player keys, bomb drops and revive; never pause or quit
+    const char RANDOM_KEYS[] = "wdxasilmjkeor";
+    constexpr int RANDOM_KEY_ONE_IN = 3; // chance of a key press per tick
+
+    SessionResult runSession(const GameAssets& assets, const InputLog* script, unsigned seed, int maxTicks) {
+        SessionResult result;
+        SessionRecorder recorder(result, assets.getScreenCount());
+        std::mt19937 rng(seed);
+
+        GameOptions options;
+        options.assets = &assets;
+        if (script) options.startMap = script->getHeader().startMap;
+
+        NullSink sink;
+        Game game(&sink, options);
+        game.setObserver(&recorder);
+
+        // Riddle answers: recorded ones in order, or a random choice
+        std::vector<char> answers;
+        if (script) {
+            for (const InputLog::Entry& e : script->getEntries()) {
+                if (e.kind == InputLog::Kind::RIDDLE_ANSWER) answers.push_back(e.key);
+            }
+        }
+        size_t nextAnswer = 0;
+        game.setRiddleAnswerSource([&]() -> char {
+            if (script) return nextAnswer < answers.size() ? answers[nextAnswer++] : GameConstants::KEY_ESC;
+            return (char)('A' + rng() % 3);
+        });
+
+        if (!game.begin()) return result;
+        result.outcome = Outcome::TIMED_OUT;
+
+        size_t nextEntry = 0;
+        while (game.isRunning() && game.getTickCount() < maxTicks) {
+            if (script) {
+                const auto& entries = script->getEntries();
+                for (; nextEntry < entries.size() && entries[nextEntry].tick <= game.getTickCount(); ++nextEntry) {
+                    if (entries[nextEntry].kind == InputLog::Kind::KEY && game.isRunning()) {
+                        game.handleInput(entries[nextEntry].key);
+                    }
+                }
+            }
+            else if (rng() % RANDOM_KEY_ONE_IN == 0) {
+                game.handleInput(RANDOM_KEYS[rng() % (sizeof(RANDOM_KEYS) - 1)]);
+            }
+            if (!game.isRunning()) break;
+            game.tick();
+        }
+
+        if (!game.isRunning() && result.outcome != Outcome::FINISHED) {
+            result.outcome = Outcome::ENDED;
+        }
+        result.ticks = game.getTickCount();
+        return result;
+    }
+
+    bool parseSimulationOptions(const std::vector<std::string>& args, SimulationOptions& options) {
+        for (size_t i = 0; i < args.size(); ++i) {
+            if (i + 1 >= args.size()) return false;
+            const std::string& arg = args[i];
+            const std::string& value = args[++i];
+
+            if (arg == "--sessions") options.sessions = std::atoi(value.c_str());
+            else if (arg == "--threads") options.threads = (unsigned)std::atoi(value.c_str());
+            else if (arg == "--ticks") options.maxTicks = std::atoi(value.c_str());
+            else if (arg == "--seed") options.seed = (unsigned)std::strtoul(value.c_str(), nullptr, 10);
+            else if (arg == "--policy") options.policy = value;
+            else return false;
+        }
+        return options.sessions > 0 && options.maxTicks > 0;
+    }
+
+    std::string baseName(const std::string& path) {
+        size_t slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? path : path.substr(slash + 1);
+    }
+
+    double perVisit(long long count, long long visits) {
+        return visits ? (double)count / (double)visits : 0.0;
+    }
+}
+
+int runSimulation(const std::vector<std::string>& args) {
+    SimulationOptions options;
+    if (!parseSimulationOptions(args, options)) {
+        std::fprintf(stderr, "usage: game --simulate [--sessions n] [--threads n] [--ticks n] [--seed n] [--policy random|<input log>]\n");
+        return 1;
+    }
+
+    // Level set, riddles and script are loaded once and shared read-only by all sessions
+    std::string error;
+    GameAssets assets;
+    if (!assets.load(error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    InputLog script;
+    bool scripted = options.policy != "random";
+    if (scripted && !script.load(options.policy, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    std::vector<SessionResult> results(options.sessions);
+    auto start = std::chrono::steady_clock::now();
+    unsigned threadCount;
+    {
+        WorkStealingPool pool(options.threads);
+        threadCount = pool.size();
+        for (int i = 0; i < options.sessions; ++i) {
+            pool.submit([&, i] {
+                results[i] = runSession(assets, scripted ? &script : nullptr, options.seed + (unsigned)i, options.maxTicks);
+            });
+        }
+        pool.wait();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Merge
+    int mapCount = assets.getScreenCount();
+    std::vector<MapStats> maps(mapCount);
+    std::vector<LatencyHistogram> ticksToDoor(mapCount);
+    long long outcomes[4] = {};
+    long long totalTicks = 0;
+    for (const SessionResult& r : results) {
+        ++outcomes[(int)r.outcome];
+        totalTicks += r.ticks;
+        for (int m = 0; m < (int)r.maps.size(); ++m) {
+            const MapStats& s = r.maps[m];
+            maps[m].visits += s.visits;
+            maps[m].completions += s.completions;
+            maps[m].bombHits += s.bombHits;
+            maps[m].riddlesAsked += s.riddlesAsked;
+            maps[m].riddlePenalties += s.riddlePenalties;
+            for (long long t : s.ticksToDoor) ticksToDoor[m].record((uint64_t)t);
+        }
+    }
+
+    std::printf("%d sessions (%s policy), %u threads, %.2f s: %.0f sessions/s, %.0f ticks/s\n",
+        options.sessions, scripted ? "scripted" : "random", threadCount, seconds,
+        options.sessions / seconds, totalTicks / seconds);
+    std::printf("finished %lld, ended %lld, timed out %lld, failed to start %lld\n\n",
+        outcomes[(int)Outcome::FINISHED], outcomes[(int)Outcome::ENDED],
+        outcomes[(int)Outcome::TIMED_OUT], outcomes[(int)Outcome::FAILED]);
+
+    std::printf("%-26s %8s %9s %10s %10s %10s %10s %10s\n", "map", "visits", "complete",
+        "door p50", "door p90", "bomb hits", "riddles", "penalties");
+    for (int m = 0; m < mapCount; ++m) {
+        const MapStats& s = maps[m];
+        if (s.visits == 0) continue;
+        std::printf("%-26s %8lld %8.1f%% %10llu %10llu %10.2f %10.2f %10.2f\n",
+            baseName(assets.getScreenFiles()[m]).c_str(), s.visits,
+            100.0 * perVisit(s.completions, s.visits),
+            (unsigned long long)ticksToDoor[m].percentile(50.0),
+            (unsigned long long)ticksToDoor[m].percentile(90.0),
+            perVisit(s.bombHits, s.visits), perVisit(s.riddlesAsked, s.visits),
+            perVisit(s.riddlePenalties, s.visits));
+    }
+    std::printf("\n(bomb hits, riddles and penalties are per visit; door ticks count from entering the map)\n");
+    return outcomes[(int)Outcome::FAILED] ? 1 : 0;
+}
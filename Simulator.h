@@ -0,0 +1,15 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Monte Carlo level balancing (run with: game --simulate [options]).
+// Plays many headless sessions with the real game rules on a work-stealing thread
+// pool and reports per-map completion rate, ticks to door, bomb hits and riddle
+// penalties. Options:
+//   --sessions <n>   number of sessions (default 1000)
+//   --threads <n>    worker threads (default: all hardware threads)
+//   --ticks <n>      tick limit per session (default 6000, ten minutes at 10 Hz)
+//   --seed <n>       seed of the first session; session i uses seed + i (default 1)
+//   --policy <p>     "random" (default) or an input log recorded with --record
+// Returns the process exit code.
+int runSimulation(const std::vector<std::string>& args);
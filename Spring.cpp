@@ -5,6 +5,9 @@
 #include "Direction.h"
 #include "Constants.h"
 #include "utils.h"
+#include "TimerWheel.h"
+#include "GameContext.h"
+#include <algorithm>
 
 using namespace GameConstants;
 
@@ -103,8 +106,8 @@ bool Spring::handleCompression(Player& player, Screen& screen) {
 }
 
 void Spring::releaseSpring(Player& player) {
-    // No direction or no energy - cannot launch
-    if (player.spring.energy <= 0 || (player.spring.dx == 0 && player.spring.dy == 0))
+    // No direction or no energy (or nothing to time the launch) - cannot launch
+    if (player.spring.energy <= 0 || (player.spring.dx == 0 && player.spring.dy == 0) || !player.context)
     {
         player.spring.reset();
         return;
@@ -113,7 +116,11 @@ void Spring::releaseSpring(Player& player) {
     // Calculate launch parameters
     LaunchData launch = calculateLaunch(player.spring.energy);
     player.spring.launch_speed = launch.launch_speed;
-    player.spring.launch_turns = launch.launch_turns;
+    player.spring.launching = true;
+
+    // The launch moves the player on the next launch_turns cycles; it ends after the last one
+    unsigned generation = ++player.launchGeneration;
+    player.context->timers.schedule(launch.launch_turns + 1, [&player, generation] { expireLaunch(player, generation); });
 
     // Launch opposite to compression direction
     player.spring.launch_dx = -player.spring.dx;
@@ -125,8 +132,14 @@ void Spring::releaseSpring(Player& player) {
     player.spring.dy = 0;
 }
 
+void Spring::expireLaunch(Player& player, unsigned generation) {
+    if (generation == player.launchGeneration) {
+        player.spring.launching = false;
+    }
+}
+
 bool Spring::updateLaunch(Player& player, Screen& screen) {
-    if (player.spring.launch_turns <= 0) {
+    if (!player.spring.launching) {
         // Clear launch state when launch is over
         player.spring.launch_speed = 0;
         player.spring.launch_dx = 0;
@@ -134,9 +147,6 @@ bool Spring::updateLaunch(Player& player, Screen& screen) {
         return false;
     }
 
-    // One game cycle passed
-    player.spring.launch_turns--;
-
     Point playerPos = player.getPosition();
 
     // User side movement (allowed as long as not opposite to launch)
@@ -150,7 +160,8 @@ bool Spring::updateLaunch(Player& player, Screen& screen) {
         sideMove.setX(sideMove.getX() + user_dx);
         sideMove.setY(sideMove.getY() + user_dy);
 
-        if (!screen.isWall(sideMove)) {
+        CellProbe sideCell = screen.probe(sideMove);
+        if (!sideCell.is(CellProbe::SOLID) && !(sideCell.players & ~Screen::occupantBit(player.getIndex()))) {
             char bg = screen.getCharAt(playerPos);
             playerPos.draw(bg);
 
@@ -160,53 +171,53 @@ bool Spring::updateLaunch(Player& player, Screen& screen) {
         }
     }
 
-    // Apply launch movement (speed can be >1)
-    for (int i = 0; i < player.spring.launch_speed; ++i)
+    // Apply launch movement (speed can be >1): fly over the free cells, up to any other
+    // player, in one jump, then let whatever stopped the flight decide whether it goes on
+    int dx = player.spring.launch_dx;
+    int dy = player.spring.launch_dy;
+    Direction dir = Direction::STAY;
+    if (dx == 1 && dy == 0) dir = Direction::RIGHT;
+    else if (dx == -1 && dy == 0) dir = Direction::LEFT;
+    else if (dx == 0 && dy == 1) dir = Direction::DOWN;
+    else if (dx == 0 && dy == -1) dir = Direction::UP;
+
+    int remaining = dir == Direction::STAY ? 0 : player.spring.launch_speed;
+    while (remaining > 0)
     {
         playerPos = player.getPosition();
-        Point fly = playerPos;
-
-        fly.setX(fly.getX() + player.spring.launch_dx);
-        fly.setY(fly.getY() + player.spring.launch_dy);
-
-        char flyChar = screen.getCharAt(fly);
-
-        // Obstacle collision - let obstacle handle push with spring force
-        if (flyChar == OBSTACLE) {
-            Obstacle* obs = screen.getObstacleAt(fly);
-            if (obs && obs->handleCollision(player, screen)) {
-                // Obstacle was pushed, player moved into that spot
-                // Continue launch if turns remain
-                continue;
-            }
-            // Could not push obstacle - stop launch
-            player.spring.launch_turns = 0;
-            break;
+        int jump = std::min(remaining, screen.launchRun(playerPos, dir, player.getIndex()));
+        if (jump > 0) {
+            // Regular flight: redraw only where the player took off and where it lands
+            char bg = screen.getCharAt(playerPos);
+            playerPos.draw(bg);
+            player.moveToPositionPreserveSpring(Point(playerPos.getX() + jump * dx, playerPos.getY() + jump * dy));
+            player.draw();
+            remaining -= jump;
+            continue;
         }
 
-        if (flyChar >= DOOR_START && flyChar <= DOOR_END) {
-            player.spring.launch_turns = 0;
-            break;
-        }
+        // The next cell blocks: a wall, door, player or obstacle
+        Point fly(playerPos.getX() + dx, playerPos.getY() + dy);
 
-        // Player collision - transfer momentum
-        // Note: This requires multi-player support which needs refactoring
-        if (flyChar == PLAYER_1 || flyChar == PLAYER_2) {
-            player.spring.launch_turns = 0;
+        CellProbe flyCell = screen.probe(fly);
+
+        // Player collision - another player stops the flight
+        if (flyCell.players & ~Screen::occupantBit(player.getIndex())) {
+            player.spring.launching = false;
             break;
         }
 
-        // Wall blocks launch
-        if (screen.isWall(fly)) {
-            player.spring.launch_turns = 0;
-            break;
+        // Obstacle collision - let obstacle handle push with spring force
+        if (flyCell.is(CellProbe::PUSHABLE) && screen.hasObstacleAt(fly) && screen.collide(flyCell.entity, player)) {
+            // Obstacle was pushed, player moved into that spot
+            // Continue launch if turns remain
+            --remaining;
+            continue;
         }
 
-        // Regular launch step
-        char bg = screen.getCharAt(playerPos);
-        playerPos.draw(bg);
-        player.moveToPositionPreserveSpring(fly);
-        player.draw();
+        // Anything else (or an obstacle that did not move) ends the launch
+        player.spring.launching = false;
+        break;
     }
 
     return true;
@@ -221,8 +232,8 @@ bool Spring::handleCurrentPosition(Player& player, Screen& screen) {
     Point next = playerPos;
     next.move();
 
-    char currentChar = screen.getCharAt(playerPos);
-    char nextChar = screen.getCharAt(next);
+    char currentChar = screen.charAtUnchecked(playerPos);
+    char nextChar = screen.charAtUnchecked(next);
 
     bool shouldRelease = false;
 
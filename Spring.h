@@ -5,7 +5,7 @@
 class Player;
 class Screen;
 
-class Spring : public GameObject {
+class Spring final : public GameObject {
     Point position;
 
 public:
@@ -26,6 +26,9 @@ public:
     // Release compressed spring energy
     static void releaseSpring(Player& player);
 
+    // Scheduled end of a launch; ignored if a newer launch has started since
+    static void expireLaunch(Player& player, unsigned generation);
+
 private:
     // Internal physics calculations
     struct LaunchData {
@@ -30,19 +30,14 @@ bool Switch::handleCollision(Player& player, Screen& screen) {
     Point oldPos = playerPos;
     player.setInitPosition(position);
 
-    // Visual update using performMoveVisuals-like logic
-    if (player.getHeldItemChar() == TORCH) {
-        screen.updateTorchLocation(oldPos, position, Torch::RADIUS);
-    } else {
-        screen.drawCharOnly(oldPos.getX(), oldPos.getY());
-    }
+    // Visual update like performMoveVisuals (a held torch's light follows in updateLight)
+    screen.drawCharOnly(oldPos.getX(), oldPos.getY());
     player.draw();
 
     return true;
 }
 
 void Switch::activate(Player& player, Screen& screen) {
-    toggle();
-    char c = isOn ? SWITCH_ON : SWITCH_OFF;
-    screen.setCharAt(position, c);
+    // Screen toggles this switch and updates its group's ON count
+    screen.toggleSwitch(position);
 }
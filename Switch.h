@@ -6,7 +6,7 @@
 class Player;
 class Screen;
 
-class Switch : public GameObject {
+class Switch final : public GameObject {
     Point position;
     bool isOn;
     int groupId;
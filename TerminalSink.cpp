@@ -0,0 +1,62 @@
+#include "TerminalSink.h"
+#include "console.h"
+#include "utils.h"
+
+namespace {
+    void appendNumber(std::string& out, int value) {
+        char digits[12];
+        int len = 0;
+        do {
+            digits[len++] = (char)('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        while (len > 0) out.push_back(digits[--len]);
+    }
+}
+
+TerminalSink::TerminalSink() {
+    frameBytes.reserve(WIDTH * HEIGHT * 8);
+}
+
+void TerminalSink::appendCursorMove(int x, int y) {
+    frameBytes += "\033[";
+    appendNumber(frameBytes, y + 1);
+    frameBytes.push_back(';');
+    appendNumber(frameBytes, x + 1);
+    frameBytes.push_back('H');
+}
+
+void TerminalSink::beginFrame() {
+    frameBytes.clear();
+    cursorX = cursorY = -1; // other output may have moved the cursor since the last frame
+}
+
+void TerminalSink::writeRun(int x, int y, const RenderCell* cells, int count) {
+    ColorState& colorState = terminal_color_state();
+
+    // Jump only where a run of changed cells breaks
+    if (x != cursorX || y != cursorY) appendCursorMove(x, y);
+
+    for (int i = 0; i < count; ++i) {
+        const RenderCell& cell = cells[i];
+        // Blanks look the same in any color, so they never force an escape
+        if (useColors && cell.ch != ' ' && colorState.change(static_cast<Color>(cell.color))) {
+            frameBytes += ansi_color_code(static_cast<Color>(cell.color));
+        }
+        frameBytes.push_back(cell.ch);
+    }
+
+    cursorX = x + count;
+    cursorY = y;
+}
+
+void TerminalSink::endFrame() {
+    lastFrameBytes = frameBytes.size();
+    if (frameBytes.empty()) return;
+    write_console(frameBytes.data(), frameBytes.size());
+}
+
+void TerminalSink::clear() {
+    clrscr();
+    hideCursor();
+}
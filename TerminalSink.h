@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+#include "RenderSink.h"
+
+// ANSI terminal output: coalesces a frame into one byte string and writes it with one call
+class TerminalSink : public RenderSink {
+    std::string frameBytes; // reused between frames to avoid reallocation
+    size_t lastFrameBytes = 0;
+    int cursorX = -1; // where the terminal cursor sits after the previous run
+    int cursorY = -1;
+    bool useColors = true; // false: plain characters, no color escapes
+
+    void appendCursorMove(int x, int y);
+
+public:
+    TerminalSink();
+
+    void beginFrame() override;
+    void writeRun(int x, int y, const RenderCell* cells, int count) override;
+    void endFrame() override;
+    void clear() override;
+    bool isInteractive() const override { return true; }
+
+    void setColors(bool enabled) { useColors = enabled; }
+
+    // Number of bytes the last frame wrote to the terminal
+    size_t getLastFrameBytes() const { return lastFrameBytes; }
+};
@@ -0,0 +1,49 @@
+#include "TickScheduler.h"
+#include <thread>
+
+TickScheduler::TickScheduler(int ticksPerSecond, int maxCatchUpTicks)
+    : maxCatchUp(maxCatchUpTicks < 1 ? 1 : maxCatchUpTicks),
+    tickRate(ticksPerSecond < 1 ? 1 : ticksPerSecond)
+{
+    period = std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / tickRate;
+    nextDeadline = Clock::now();
+}
+
+void TickScheduler::start() {
+    nextDeadline = Clock::now();
+}
+
+int TickScheduler::due() {
+    Clock::time_point now = Clock::now();
+    if (now < nextDeadline) {
+        std::this_thread::sleep_until(nextDeadline);
+        now = Clock::now();
+    }
+
+    Clock::duration late = now - nextDeadline;
+    lateness.record((uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(late).count());
+
+    int ticks = 1 + (int)(late / period);
+    if (ticks > maxCatchUp) {
+        // too far behind to catch up (a stall, not an overrun): skip the missed
+        // ticks and start a fresh schedule with this one
+        ticksDropped += ticks - 1;
+        ticks = 1;
+        nextDeadline = now + period;
+    }
+    else {
+        nextDeadline += period * ticks;
+    }
+
+    ticksRun += ticks;
+    return ticks;
+}
+
+void TickScheduler::writeReport(std::ostream& out) const {
+    out << "tick rate: " << tickRate << " Hz (period "
+        << std::chrono::duration_cast<std::chrono::microseconds>(period).count() << " us)\n";
+    out << "ticks run: " << ticksRun << ", dropped: " << ticksDropped << '\n';
+    lateness.writeSummary(out, "lateness (us):");
+    out << "lateness buckets (us, count):\n";
+    lateness.writeBuckets(out);
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <chrono>
+#include <ostream>
+#include "LatencyHistogram.h"
+
+// Fixed-timestep pacing on absolute steady_clock deadlines.
+// Each deadline is the previous one plus exactly one period, so the time spent
+// simulating and rendering does not stretch the cycle. When a cycle starts late
+// by whole periods the missed ticks are run back to back, up to maxCatchUp; past
+// that only one tick runs and the schedule restarts from now (e.g. after a riddle
+// blocked the loop), so a stall isn't followed by a burst of ticks.
+class TickScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int DEFAULT_MAX_CATCH_UP = 3;
+
+private:
+    Clock::duration period;
+    Clock::time_point nextDeadline;
+    int maxCatchUp;
+
+    LatencyHistogram lateness; // microseconds between a deadline and the cycle actually starting
+    long long ticksRun = 0;
+    long long ticksDropped = 0;
+    int tickRate;
+
+public:
+    explicit TickScheduler(int ticksPerSecond, int maxCatchUpTicks = DEFAULT_MAX_CATCH_UP);
+
+    // First deadline is now
+    void start();
+
+    // When the current cycle should start
+    Clock::time_point deadline() const { return nextDeadline; }
+
+    // Waits out the deadline if it hasn't passed, records the lateness and moves on
+    // to the next deadline. Returns how many ticks to run now (at least one).
+    int due();
+
+    int getTickRate() const { return tickRate; }
+    const LatencyHistogram& getLateness() const { return lateness; }
+
+    // Tick counts and the lateness histogram, for dumping on exit
+    void writeReport(std::ostream& out) const;
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include "Constants.h"
+#include "console.h"
+#include <array>
+#include <cstdint>
+
+// What every glyph means to the game, built once at compile time. Movement,
+// map parsing, explosions and drawing read one row instead of comparing the
+// character against each constant; a new tile type is one new row here.
+namespace Tiles
+{
+    enum Flag : std::uint8_t {
+        SOLID = 1,         // blocks movement and light
+        PUSHABLE = 2,      // moved out of the way when walked into
+        COLLECTIBLE = 4,   // picked up when walked onto
+        DOOR = 8,          // leads to another level
+        INTERACTIVE = 16,  // reacts to a player stepping on it
+        HIDDEN = 32,       // drawn only while lit
+        BLAST_PROOF = 64   // survives explosions
+    };
+
+    // Which code takes over when the glyph is parsed or stepped on
+    enum class Handler : std::uint8_t {
+        NONE, KEY, BOMB, TORCH, OBSTACLE, SPRING, SWITCH, RIDDLE, DOOR, LEGEND
+    };
+
+    struct Info {
+        std::uint8_t flags = 0;
+        Handler handler = Handler::NONE;
+        std::uint8_t color = static_cast<std::uint8_t>(Color::White);
+
+        constexpr bool has(Flag flag) const { return (flags & flag) != 0; }
+    };
+
+    constexpr std::array<Info, 256> makeTable()
+    {
+        using namespace GameConstants;
+        std::array<Info, 256> table{};
+        auto row = [&table](char c, std::uint8_t flags, Handler handler, Color color) {
+            table[static_cast<unsigned char>(c)] = Info{ flags, handler, static_cast<std::uint8_t>(color) };
+        };
+
+        row(WALL, SOLID, Handler::NONE, Color::DarkGrey);
+        row(WALL_X, SOLID | HIDDEN, Handler::NONE, Color::White);
+        // players are never on the board; these rows only give their glyphs a colour
+        row(PLAYER_1, 0, Handler::NONE, Color::LightGreen);
+        row(PLAYER_2, 0, Handler::NONE, Color::LightCyan);
+        row(KEY, COLLECTIBLE | BLAST_PROOF, Handler::KEY, Color::LightCyan);
+        row(BOMB, COLLECTIBLE, Handler::BOMB, Color::White);
+        row(TORCH, COLLECTIBLE, Handler::TORCH, Color::White);
+        row(OBSTACLE, PUSHABLE, Handler::OBSTACLE, Color::LightRed);
+        row(SPRING, INTERACTIVE, Handler::SPRING, Color::Yellow);
+        row(SWITCH_OFF, INTERACTIVE, Handler::SWITCH, Color::White);
+        row(SWITCH_ON, INTERACTIVE, Handler::SWITCH, Color::White);
+        row(RIDDLE, INTERACTIVE, Handler::RIDDLE, Color::LightMagenta);
+        for (char d = DOOR_START; d <= DOOR_END; ++d)
+            row(d, DOOR | BLAST_PROOF, Handler::DOOR, Color::LightBlue);
+        row('L', 0, Handler::LEGEND, Color::White); // legend marker, only seen while parsing
+        return table;
+    }
+
+    inline constexpr std::array<Info, 256> TABLE = makeTable();
+
+    constexpr const Info& of(char c) { return TABLE[static_cast<unsigned char>(c)]; }
+}
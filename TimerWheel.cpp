@@ -0,0 +1,42 @@
+#include "TimerWheel.h"
+
+void TimerWheel::schedule(int delayTicks, Callback action) {
+    if (delayTicks < 1) delayTicks = 1;
+
+    long long due = currentTick + delayTicks;
+    slots[due & (SLOTS - 1)].push_back({ due, std::move(action) });
+    ++pending;
+}
+
+void TimerWheel::advance() {
+    ++currentTick;
+    std::vector<Event>& slot = slots[currentTick & (SLOTS - 1)];
+
+    // Split the slot into due events and ones a full turn (or more) ahead, keeping order
+    firing.clear();
+    size_t kept = 0;
+    for (size_t i = 0; i < slot.size(); ++i) {
+        if (slot[i].dueTick == currentTick) {
+            firing.push_back(std::move(slot[i].action));
+        }
+        else {
+            if (kept != i) slot[kept] = std::move(slot[i]);
+            ++kept;
+        }
+    }
+    slot.resize(kept);
+    pending -= firing.size();
+
+    // Callbacks may schedule new events; they never land in this tick
+    for (size_t i = 0; i < firing.size(); ++i) {
+        firing[i]();
+    }
+    firing.clear();
+}
+
+void TimerWheel::clear() {
+    for (auto& slot : slots) {
+        slot.clear();
+    }
+    pending = 0;
+}
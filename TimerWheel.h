@@ -0,0 +1,38 @@
+#pragma once
+#include <functional>
+#include <vector>
+
+// Hashed timer wheel keyed by game tick.
+// An event lives in slot (dueTick % SLOTS); advance() only visits the slot of the
+// new tick, so a game cycle costs as much as the events that fall due on it,
+// not as much as the number of timed objects on the map.
+class TimerWheel {
+public:
+    using Callback = std::function<void()>;
+
+    static constexpr int SLOTS = 64; // power of two; longer delays just wrap around
+
+private:
+    struct Event {
+        long long dueTick;
+        Callback action;
+    };
+
+    std::vector<Event> slots[SLOTS];
+    std::vector<Callback> firing; // due events of the current tick (reused)
+    long long currentTick = 0;
+    size_t pending = 0;
+
+public:
+    // Run action delayTicks cycles from now (at least one)
+    void schedule(int delayTicks, Callback action);
+
+    // Move to the next tick and run its events in the order they were scheduled
+    void advance();
+
+    // Drop every pending event (the tick counter keeps running)
+    void clear();
+
+    long long now() const { return currentTick; }
+    size_t size() const { return pending; }
+};
@@ -19,13 +19,15 @@ bool Torch::handleCollision(Player& player, Screen& screen) {
 
     if (canCollect(player))
     {
+        // collect() removes this torch from the screen's list, so keep its position first
+        Point torchPos = position;
         collect(player, screen);
 
         // Move player to torch position
         Point playerPos = player.getPosition();
         char bg = screen.getCharAt(playerPos);
         playerPos.draw(bg);
-        player.setInitPosition(position);
+        player.setInitPosition(torchPos);
         player.draw();
 
         return true;
@@ -41,7 +43,8 @@ bool Torch::canCollect(const Player& player) const {
 void Torch::collect(Player& player, Screen& screen) {
     player.pickupTorch();
 
-    screen.setCharAt(position, EMPTY);
-	screen.removeTorch(position);
-    screen.refreshArea(position.getX(), position.getY(), RADIUS);
+    Point torchPos = position; // removeTorch() may overwrite this object
+    screen.setCharAt(torchPos, EMPTY);
+	screen.removeTorch(torchPos);
+    screen.removeLight(torchPos); // the player's held light takes over (Player::updateLight)
 }
\ No newline at end of file
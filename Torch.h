@@ -5,7 +5,7 @@
 class Player;
 class Screen;
 
-class Torch : public GameObject {
+class Torch final : public GameObject {
     Point position;
 
 public:
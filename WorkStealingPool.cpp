@@ -0,0 +1,89 @@
+#include "WorkStealingPool.h"
+
+WorkStealingPool::WorkStealingPool(unsigned threadCount) {
+    if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0) threadCount = 1;
+
+    for (unsigned i = 0; i < threadCount; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threads.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto& thread : threads) thread.join();
+}
+
+void WorkStealingPool::submit(Task task) {
+    size_t target = nextWorker.fetch_add(1) % workers.size();
+    {
+        std::lock_guard<std::mutex> guard(workers[target]->lock);
+        workers[target]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        ++queued;
+    }
+    workAvailable.notify_one();
+}
+
+bool WorkStealingPool::takeTask(size_t self, Task& task) {
+    // own deque: newest first
+    {
+        Worker& own = *workers[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    // steal: oldest task of the next non-empty worker
+    for (size_t i = 1; i < workers.size(); ++i) {
+        Worker& victim = *workers[(self + i) % workers.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(size_t self) {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> guard(stateLock);
+            workAvailable.wait(guard, [this] { return queued > 0 || stopping; });
+            if (queued == 0 && stopping) return;
+            // reserve one task; it is in some deque until takeTask() finds it
+            --queued;
+            ++running;
+        }
+
+        Task task;
+        while (!takeTask(self, task)) {
+            std::this_thread::yield(); // submit() pushes before counting, so this is brief
+        }
+        task();
+
+        {
+            std::lock_guard<std::mutex> guard(stateLock);
+            --running;
+            if (queued == 0 && running == 0) allDone.notify_all();
+        }
+    }
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> guard(stateLock);
+    allDone.wait(guard, [this] { return queued == 0 && running == 0; });
+}
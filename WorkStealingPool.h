@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads, each with its own task deque.
+// A worker takes its newest task first and, when its deque is empty, steals the
+// oldest task of another worker, so uneven task lengths still keep every core busy.
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+private:
+    struct Worker {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::mutex stateLock;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+    size_t queued = 0;   // tasks submitted but not yet taken (guarded by stateLock)
+    size_t running = 0;  // tasks being executed (guarded by stateLock)
+    bool stopping = false;
+    std::atomic<size_t> nextWorker{ 0 };
+
+    bool takeTask(size_t self, Task& task);
+    void workerLoop(size_t self);
+
+public:
+    // threadCount 0 uses every hardware thread
+    explicit WorkStealingPool(unsigned threadCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(Task task);
+
+    // Block until every submitted task has finished
+    void wait();
+
+    unsigned size() const { return (unsigned)threads.size(); }
+};
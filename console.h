@@ -26,6 +26,7 @@
 #include <termios.h>
 #include <fcntl.h>
 #include <sys/select.h> // Required for reliable kbhit on Mac
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <cstdlib>
 #include <cstdio>
@@ -115,15 +116,45 @@ inline bool check_kbhit() {
 }
 
 // Read one char immediately
+// Uses read() rather than getchar() so no bytes sit in a stdio buffer that
+// check_kbhit() and wait_for_input() cannot see
 inline int get_single_char() {
-    return getchar();
+    unsigned char c;
+    return (read(STDIN_FILENO, &c, 1) == 1) ? c : EOF;
+}
+
+// Block until input arrives or timeoutMs passes, then take everything pending in one read()
+// Returns the number of bytes stored (0 on timeout), or -1 once stdin is closed
+inline int wait_for_input(char* buffer, int capacity, int timeoutMs) {
+    struct pollfd pfd = { STDIN_FILENO, POLLIN, 0 };
+    if (poll(&pfd, 1, timeoutMs < 0 ? 0 : timeoutMs) <= 0) return 0;
+
+    ssize_t n = read(STDIN_FILENO, buffer, (size_t)capacity);
+    return (n > 0) ? (int)n : -1;
 }
 
 #else 
 // Windows implementations...
 inline bool check_kbhit() { return _kbhit(); }
 inline int get_single_char() { return _getch(); }
-inline void init_terminal() {} // Not needed on Windows
+inline int wait_for_input(char* buffer, int capacity, int timeoutMs) {
+    // The input handle is also signalled by mouse/focus events, so drain by _kbhit()
+    if (WaitForSingleObject(GetStdHandle(STD_INPUT_HANDLE), timeoutMs < 0 ? 0 : (DWORD)timeoutMs) != WAIT_OBJECT_0) return 0;
+
+    int n = 0;
+    while (n < capacity && _kbhit()) {
+        buffer[n++] = (char)_getch();
+    }
+    if (n == 0) Sleep(1); // non-key event pending; don't spin on it
+    return n;
+}
+inline void init_terminal() { // Enable ANSI sequences so the frame renderer works on Windows 10+
+    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (GetConsoleMode(hOut, &mode)) {
+        SetConsoleMode(hOut, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    }
+}
 inline void restore_terminal() {}
 #endif
 
@@ -169,8 +200,58 @@ inline void sleep_ms(int milliseconds) {
 #endif
 }
 
+// ANSI SGR sequence for each Color, indexed by the enum value
+constexpr int NUM_COLORS = 16;
+constexpr const char* ANSI_COLOR_CODES[NUM_COLORS] = {
+    "\033[30m", "\033[34m", "\033[32m", "\033[36m", "\033[31m", "\033[35m", "\033[33m", "\033[37m",
+    "\033[90m", "\033[94m", "\033[92m", "\033[96m", "\033[91m", "\033[95m", "\033[93m", "\033[97m"
+};
+
+// ANSI SGR sequence for a color (used by set_color on Unix and by the frame renderer)
+inline const char* ansi_color_code(Color color) {
+    return ANSI_COLOR_CODES[static_cast<int>(color)];
+}
+
+// Remembers the attribute the terminal is currently using so an escape is only
+// emitted when the color actually changes. Shared by set_color() and the renderer.
+class ColorState {
+    int current = -1; // -1 = unknown (nothing emitted yet)
+
+public:
+    // Returns true if the terminal must be switched to 'color' (and records it as current)
+    bool change(Color color) {
+        if (current == static_cast<int>(color)) return false;
+        current = static_cast<int>(color);
+        return true;
+    }
+    void invalidate() { current = -1; }
+};
+
+inline ColorState& terminal_color_state() {
+    static ColorState state;
+    return state;
+}
+
+// Write a whole buffer to the terminal with a single system call (retried on partial writes)
+inline void write_console(const char* data, size_t length) {
+    std::cout.flush(); // keep ordering with anything still buffered in std::cout
+#ifdef PLATFORM_WINDOWS
+    DWORD written = 0;
+    WriteFile(GetStdHandle(STD_OUTPUT_HANDLE), data, (DWORD)length, &written, NULL);
+#else
+    while (length > 0) {
+        ssize_t written = write(STDOUT_FILENO, data, length);
+        if (written <= 0) return;
+        data += written;
+        length -= (size_t)written;
+    }
+#endif
+}
+
 // Cross-platform color system - AI-assisted implementation 
 inline void set_color(Color color) {
+    if (!terminal_color_state().change(color)) return; // already showing this color
+
 #ifdef PLATFORM_WINDOWS
     int color_code = 15;
     switch (color) {
@@ -193,11 +274,7 @@ inline void set_color(Color color) {
     }
     SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), (WORD)color_code);
 #else
-    static const char* ansi_colors[] = {
-        "\033[30m", "\033[34m", "\033[32m", "\033[36m", "\033[31m", "\033[35m", "\033[33m", "\033[37m",
-        "\033[90m", "\033[94m", "\033[92m", "\033[96m", "\033[91m", "\033[95m", "\033[93m", "\033[97m"
-    };
-    std::cout << ansi_colors[static_cast<int>(color)];
+    std::cout << ansi_color_code(color);
 #endif
 }
 
@@ -215,32 +292,17 @@ inline void cleanup_console() {
 }
 
 // Sound system - AI-assisted implementation
-// Simple cross-platform audio using terminal bell character
-static bool g_soundEnabled = false;
-
-inline void setSoundEnabled(bool enabled) {
-    g_soundEnabled = enabled;
-}
-
-inline bool isSoundEnabled() {
-    return g_soundEnabled;
-}
+// Simple cross-platform audio using terminal bell character.
+// Whether sound is on is per session (GameContext::soundEnabled); this only makes the noise.
 
 // Simple cross-platform beep - works on both Windows and Mac
 // Uses terminal bell character '\a' - no external files needed
-inline void playSound(const std::string& eventName) {
-    if (!g_soundEnabled) return;
-
+inline void ring_bell(const char* /*eventName*/) {
     // Terminal bell works on all platforms without blocking
     // This is the simplest solution that doesn't require binary files
     std::cout << '\a' << std::flush;
 }
 
-// Legacy C-string version for backwards compatibility
-inline void playSound(const char* type) {
-    playSound(std::string(type));
-}
-
 // Show a centered error message box and wait for a key press (cross-platform)
 inline void showErrorMessage(const std::string& message) {
     clrscr();
@@ -2,16 +2,119 @@
 #include <stdexcept>
 #include "console.h"
 #include "Menu.h"
+#include "Benchmark.h"
+#include "Replay.h"
+#include "Simulator.h"
+#include "GameOptions.h"
+#include "GameAssets.h"
+#include "LevelPack.h"
+#include <string>
+#include <vector>
+#include <cstdlib>
 
 using std::cerr;
 using std::endl;
 
-int main()
+namespace {
+    void printUsage()
+    {
+        cerr << "usage: game [--tick-rate <hz>] [--tick-stats <file>] [--profile <file>]\n"
+             << "            [--map <index>] [--record <file>] [--keep-revealed]\n"
+             << "       game --replay <file>\n"
+             << "       game --simulate [--sessions n] [--threads n] [--ticks n] [--seed n] [--policy random|<file>]\n"
+             << "       game --pack [file]\n"
+             << "       game --bench <name>" << endl;
+    }
+
+    // Compiles the text screens and riddles into a level pack
+    int runPack(const std::string& filename)
+    {
+        GameAssets assets;
+        std::string error;
+        if (!assets.loadText(error) || !assets.savePack(filename, error)) {
+            cerr << error << endl;
+            return 1;
+        }
+        cerr << "packed " << assets.getScreenCount() << " screens and "
+             << assets.getRiddles().count() << " riddles into " << filename << endl;
+        return 0;
+    }
+
+    // Fills options from the command line; false on an unknown or incomplete option
+    bool parseOptions(int argc, char* argv[], GameOptions& options)
+    {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--keep-revealed") {
+                options.keepRevealed = true;
+                continue;
+            }
+            if (i + 1 >= argc) return false;
+
+            if (arg == "--tick-rate") {
+                options.tickRate = std::atoi(argv[++i]);
+                if (options.tickRate <= 0) return false;
+            }
+            else if (arg == "--tick-stats") {
+                options.tickStatsFile = argv[++i];
+            }
+            else if (arg == "--profile") {
+                options.profile = true;
+                options.profileFile = argv[++i];
+            }
+            else if (arg == "--map") {
+                options.startMap = std::atoi(argv[++i]);
+                if (options.startMap < 0) return false;
+            }
+            else if (arg == "--record") {
+                options.recordFile = argv[++i];
+            }
+            else {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
 {
+    // game --bench <name> : run a micro benchmark instead of the game
+    if (argc >= 3 && std::string(argv[1]) == "--bench") {
+        return runBenchmark(argv[2]);
+    }
+
+    // game --simulate ... : Monte Carlo level statistics over many headless sessions
+    if (argc >= 2 && std::string(argv[1]) == "--simulate") {
+        return runSimulation(std::vector<std::string>(argv + 2, argv + argc));
+    }
+
+    // game --pack [file] : build the level pack (default Data/levels.pack)
+    if ((argc == 2 || argc == 3) && std::string(argv[1]) == "--pack") {
+        return runPack(argc == 3 ? argv[2] : LevelPack::DEFAULT_FILE);
+    }
+
+    // game --replay <file> : rerun a recorded session headless, as fast as possible
+    if (argc >= 3 && std::string(argv[1]) == "--replay") {
+        return runReplay(argv[2]);
+    }
+
+    GameOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    // Levels and riddles are loaded once for every game started from the menu.
+    // On failure the game reports the problem itself when it starts.
+    GameAssets assets;
+    std::string assetError;
+    if (assets.load(assetError)) options.assets = &assets;
+
     init_console();
 
     try {
-        Menu menu;
+        Menu menu(options);
         menu.run();
     }
     catch (const std::exception& e)
@@ -1,16 +1,6 @@
 ﻿#include "utils.h"
 #include <iostream>
 
-static bool g_useColors = true;
-
 void cls() {
     clrscr();
-}
-
-void setColorMode(bool enable) {
-    g_useColors = enable;
-}
-
-bool isColorMode() {
-    return g_useColors;
 }
\ No newline at end of file
@@ -1,18 +1,4 @@
 ﻿#pragma once
 #include "console.h"
 
-void cls();
-
-void setColorMode(bool enable);
-bool isColorMode();
-
-
-inline void setTextColor(Color c) {
-    if (isColorMode()) {
-        set_color(c);
-    }
-}
-
-inline void setTextColor(int c) {
-    setTextColor(static_cast<Color>(c));
-}
\ No newline at end of file
+void cls();
\ No newline at end of file